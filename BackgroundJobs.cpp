@@ -0,0 +1,37 @@
+#include "BackgroundJobs.hpp"
+
+#include <thread>
+
+using namespace std;
+
+BackgroundJobs::BackgroundJobs(size_t channels, unsigned threads)
+    : generations(channels), pending(channels, 0), results(256), pool(threads) {}
+
+BackgroundJobs::~BackgroundJobs() {
+    // Lo que siga en cola al cerrar ya no hace falta
+    for (size_t c = 0; c < generations.size(); ++c) ++generations[c];
+}
+
+void BackgroundJobs::cancel(size_t channel) {
+    ++generations[channel];
+    pending[channel] = 0;
+}
+
+void BackgroundJobs::enqueue(size_t channel, uint64_t generation, function<void()> apply) {
+    if (generations[channel].load(memory_order_relaxed) != generation) return;
+    Message message{channel, generation, move(apply)};
+    // Si la cola se llenó, la ventana la vacía en el siguiente frame
+    while (!results.push(move(message))) {
+        if (generations[channel].load(memory_order_relaxed) != generation) return;
+        this_thread::yield();
+    }
+}
+
+void BackgroundJobs::drain() {
+    Message message;
+    while (results.pop(message)) {
+        if (message.generation != generations[message.channel].load(memory_order_relaxed)) continue;
+        if (message.apply) message.apply();
+        pending[message.channel] = 0;
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "LockFreeQueue.hpp"
+#include "ThreadPool.hpp"
+
+// Trabajos en segundo plano que devuelven sus resultados al hilo de la ventana.
+// Cada canal (un panel, un slot...) tiene un contador de generación: lanzar un
+// trabajo nuevo en un canal deja obsoletos los anteriores, que dejan de
+// calcular en cuanto lo notan (consultando Token::stale) y cuyos resultados se
+// descartan. Cada trabajo entrega un único resultado, como una función que
+// drain() ejecuta en el hilo de la ventana, a través de una cola sin locks.
+class BackgroundJobs {
+public:
+    // Lo que recibe cada trabajo para saber si sigue vigente
+    class Token {
+    public:
+        bool stale() const { return owner->generations[channel].load(std::memory_order_relaxed) != generation; }
+
+    private:
+        friend class BackgroundJobs;
+        Token(BackgroundJobs* owner, size_t channel, uint64_t generation)
+            : owner(owner), channel(channel), generation(generation) {}
+
+        BackgroundJobs* owner;
+        size_t channel;
+        uint64_t generation;
+    };
+
+    BackgroundJobs(size_t channels, unsigned threads);
+    ~BackgroundJobs();
+
+    // work(const Token&) calcula y devuelve la función que aplica el resultado
+    // (vacía si no hay nada que aplicar)
+    template <typename Work>
+    void launch(size_t channel, Work work) {
+        uint64_t generation = ++generations[channel];
+        pending[channel] = generation;
+        pool.submit([this, channel, generation, work = std::move(work)]() mutable {
+            Token token(this, channel, generation);
+            if (token.stale()) return;
+            std::function<void()> apply = work(token);
+            enqueue(channel, generation, std::move(apply));
+        });
+    }
+
+    // Deja obsoleto lo que esté en curso en el canal sin lanzar nada
+    void cancel(size_t channel);
+
+    // En el hilo de la ventana: aplica los resultados que siguen vigentes
+    void drain();
+
+    // Hay un trabajo vigente en el canal que aún no entregó su resultado
+    bool busy(size_t channel) const { return pending[channel] != 0; }
+
+private:
+    struct Message {
+        size_t channel = 0;
+        uint64_t generation = 0;
+        std::function<void()> apply;
+    };
+
+    void enqueue(size_t channel, uint64_t generation, std::function<void()> apply);
+
+    std::vector<std::atomic<uint64_t>> generations;
+    std::vector<uint64_t> pending;      // Solo en el hilo de la ventana; 0 = nada en curso
+    LockFreeQueue<Message> results;
+    ThreadPool pool;                    // Último: se destruye antes que lo que usan los trabajos
+};
@@ -0,0 +1,157 @@
+#include "BattleSim.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+
+using namespace std;
+
+namespace {
+
+// Lo que un lado necesita para jugar un turno, precalculado contra el rival
+struct SimMove {
+    DamageDistribution hit;
+    uint8_t accuracy;      // 0 = nunca falla
+    int8_t priority;
+};
+
+struct SimSide {
+    vector<SimMove> moves;
+    int hp;
+    int speed;
+};
+
+struct SimCounts {
+    uint64_t winsA = 0;
+    uint64_t winsB = 0;
+    uint64_t draws = 0;
+    uint64_t turns = 0;
+};
+
+SimSide prepare(const DamageEngine& engine, const BattleSide& self, const BattleSide& rival) {
+    SimSide side;
+    side.hp = self.mon.stats.hp;
+    side.speed = self.mon.stats.speed;
+    for (MoveId id : self.moves) {
+        const MoveData& m = engine.move(id);
+        if (m.category == MoveCategory::Status || m.power == 0) continue;
+        side.moves.push_back({engine.distribution(self.mon, id, rival.mon), m.accuracy, m.priority});
+    }
+    return side;
+}
+
+// Daño esperado de un golpe, sin contar lo que sobra más allá de los PS del rival
+double expectedDamage(const SimMove& move, int rivalHp) {
+    const DamageDistribution& d = move.hit;
+    double critP = double(d.critNumerator) / d.critDenominator;
+    double sum = 0;
+    for (int r = 0; r < kDamageRolls; ++r) {
+        sum += (1 - critP) * min<int>(d.rolls[r], rivalHp) + critP * min<int>(d.critRolls[r], rivalHp);
+    }
+    double accuracy = move.accuracy == 0 ? 1.0 : move.accuracy / 100.0;
+    return accuracy * sum / kDamageRolls;
+}
+
+int chooseMove(const SimSide& side, int rivalHp) {
+    int best = -1;
+    double bestValue = 0;
+    for (size_t i = 0; i < side.moves.size(); ++i) {
+        double value = expectedDamage(side.moves[i], rivalHp);
+        if (value > bestValue) {
+            bestValue = value;
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+int attack(const SimMove& move, CounterRng& rng) {
+    if (move.accuracy != 0 && rng.below(100) >= move.accuracy) return 0;
+    int roll = rng.below(kDamageRolls);
+    bool crit = rng.below(move.hit.critDenominator) < move.hit.critNumerator;
+    return crit ? move.hit.critRolls[roll] : move.hit.rolls[roll];
+}
+
+SimCounts playGames(const SimSide& a, const SimSide& b, uint64_t first, uint64_t count, uint64_t seed) {
+    SimCounts counts;
+    for (uint64_t game = first; game < first + count; ++game) {
+        CounterRng rng(seed, game);
+        int hp[2] = {a.hp, b.hp};
+        const SimSide* sides[2] = {&a, &b};
+        int turn = 0;
+        int winner = -1;
+
+        for (; turn < BattleSimulator::kMaxTurns && winner < 0; ++turn) {
+            int choice[2] = {chooseMove(a, hp[1]), chooseMove(b, hp[0])};
+            if (choice[0] < 0 && choice[1] < 0) break;
+
+            // Prioridad, luego velocidad, y empate a cara o cruz
+            int priority[2] = {choice[0] < 0 ? 0 : a.moves[choice[0]].priority,
+                               choice[1] < 0 ? 0 : b.moves[choice[1]].priority};
+            int firstSide;
+            if (priority[0] != priority[1]) firstSide = priority[0] > priority[1] ? 0 : 1;
+            else if (a.speed != b.speed) firstSide = a.speed > b.speed ? 0 : 1;
+            else firstSide = static_cast<int>(rng.below(2));
+
+            for (int step = 0; step < 2; ++step) {
+                int self = step == 0 ? firstSide : 1 - firstSide;
+                int rival = 1 - self;
+                if (choice[self] < 0) continue;
+
+                hp[rival] -= attack(sides[self]->moves[choice[self]], rng);
+                if (hp[rival] <= 0) {
+                    winner = self;
+                    break;
+                }
+            }
+        }
+
+        if (winner == 0) ++counts.winsA;
+        else if (winner == 1) ++counts.winsB;
+        else ++counts.draws;
+        counts.turns += turn;
+    }
+    return counts;
+}
+
+}
+
+SimResult BattleSimulator::run(const BattleSide& a, const BattleSide& b, uint64_t games, uint64_t seed) const {
+    SimSide sideA = prepare(*engine, a, b);
+    SimSide sideB = prepare(*engine, b, a);
+
+    // Bloques fijos: el reparto de partidas no depende del número de hilos
+    const uint64_t kBlock = 1 << 14;
+    vector<future<SimCounts>> blocks;
+    for (uint64_t first = 0; first < games; first += kBlock) {
+        uint64_t count = min(kBlock, games - first);
+        blocks.push_back(pool->submit([&, first, count]() { return playGames(sideA, sideB, first, count, seed); }));
+    }
+
+    SimCounts total;
+    for (auto& block : blocks) {
+        SimCounts c = block.get();
+        total.winsA += c.winsA;
+        total.winsB += c.winsB;
+        total.draws += c.draws;
+        total.turns += c.turns;
+    }
+
+    SimResult result = {};
+    result.games = games;
+    result.winsA = total.winsA;
+    result.winsB = total.winsB;
+    result.draws = total.draws;
+    if (games == 0) return result;
+
+    double n = static_cast<double>(games);
+    double p = total.winsA / n;
+    const double z = 1.959963984540054;
+    double center = (p + z * z / (2 * n)) / (1 + z * z / n);
+    double margin = z * sqrt(p * (1 - p) / n + z * z / (4 * n * n)) / (1 + z * z / n);
+    result.winRate = p;
+    result.ciLow = max(0.0, center - margin);
+    result.ciHigh = min(1.0, center + margin);
+    result.averageTurns = total.turns / n;
+    return result;
+}
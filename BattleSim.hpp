@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "DamageEngine.hpp"
+#include "StatCalc.hpp"
+#include "ThreadPool.hpp"
+
+// Generador basado en contador: el n-ésimo número de un flujo es una función
+// pura de (clave, n). Cada partida usa como clave su índice global mezclado con
+// la semilla, así el resultado no depende de cuántos hilos haya ni de qué hilo
+// juegue cada partida.
+struct CounterRng {
+    uint64_t key;
+    uint64_t counter = 0;
+
+    CounterRng(uint64_t seed, uint64_t stream) : key(mix(seed ^ mix(stream + 0x9E3779B97F4A7C15ull))) {}
+
+    uint64_t next() { return mix(key + 0x9E3779B97F4A7C15ull * ++counter); }
+
+    // Entero uniforme en [0, n)
+    uint32_t below(uint32_t n) { return static_cast<uint32_t>(((next() >> 32) * n) >> 32); }
+
+    // Finalizador de SplitMix64
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
+
+// Un lado del combate: Pokémon con estadísticas reales y hasta 4 movimientos
+struct BattleSide {
+    Combatant mon;
+    std::vector<MoveId> moves;
+};
+
+struct SimResult {
+    uint64_t games;
+    uint64_t winsA;
+    uint64_t winsB;
+    uint64_t draws;        // Límite de turnos, o ninguno de los dos puede dañar
+    double winRate;        // Victorias de A / partidas
+    double ciLow;          // Intervalo de Wilson al 95% de winRate
+    double ciHigh;
+    double averageTurns;
+};
+
+// Simula combates 1 contra 1 completos: prioridad y velocidad deciden el orden,
+// cada ataque tira precisión, crítico y una de las 16 tiradas de daño. Cada
+// lado elige en cada turno el movimiento con mayor daño esperado (precisión *
+// E[min(daño, PS restantes)]). Las partidas se reparten en bloques entre los
+// hilos del pool.
+class BattleSimulator {
+public:
+    BattleSimulator(const DamageEngine& engine, ThreadPool& pool) : engine(&engine), pool(&pool) {}
+
+    SimResult run(const BattleSide& a, const BattleSide& b, uint64_t games, uint64_t seed = 1) const;
+
+    static constexpr int kMaxTurns = 200;
+
+private:
+    const DamageEngine* engine;
+    ThreadPool* pool;
+};
@@ -0,0 +1,105 @@
+#include "CsvReader.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+
+bool CsvReader::open(const string& filename) {
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) return false;
+
+    file.seekg(0, ios::end);
+    buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0, ios::beg);
+    file.read(&buffer[0], buffer.size());
+    pos = 0;
+
+    // BOM de UTF-8
+    if (buffer.compare(0, 3, "\xEF\xBB\xBF") == 0) pos = 3;
+    return true;
+}
+
+bool CsvReader::nextRow(vector<string_view>& fields) {
+    fields.clear();
+    if (pos >= buffer.size()) return false;
+
+    while (true) {
+        fields.push_back(pos < buffer.size() && buffer[pos] == '"' ? parseQuoted() : parseUnquoted());
+
+        if (pos >= buffer.size()) return true;
+        char c = buffer[pos];
+        if (c == ',') {
+            ++pos;
+            continue;
+        }
+        // Fin de fila: \n o \r\n
+        if (c == '\r') ++pos;
+        if (pos < buffer.size() && buffer[pos] == '\n') ++pos;
+        return true;
+    }
+}
+
+// Campo sin comillas: termina en la primera coma o fin de línea.
+// memchr está vectorizado en la libc, así que la búsqueda avanza por bloques.
+// Se busca primero la coma y el salto de línea solo antes de ella, para que
+// cada campo recorra como mucho hasta la próxima coma y no la línea entera.
+string_view CsvReader::parseUnquoted() {
+    const char* begin = buffer.data() + pos;
+    size_t remaining = buffer.size() - pos;
+
+    const char* comma = static_cast<const char*>(memchr(begin, ',', remaining));
+    size_t limit = comma ? comma - begin : remaining;
+    const char* lineEnd = static_cast<const char*>(memchr(begin, '\n', limit));
+    size_t length = lineEnd ? lineEnd - begin : limit;
+    bool endsLine = lineEnd || !comma;
+
+    pos += length;
+    if (endsLine && length > 0 && begin[length - 1] == '\r') --length;
+    return string_view(begin, length);
+}
+
+// Campo entre comillas: copia los tramos entre comillas escapadas hacia atrás
+// dentro del buffer, de modo que la vista resultante queda ya desescapada.
+string_view CsvReader::parseQuoted() {
+    char* data = &buffer[0];
+    size_t read = pos + 1;
+    size_t write = read;
+    size_t start = read;
+
+    while (read < buffer.size()) {
+        const char* quote = static_cast<const char*>(memchr(data + read, '"', buffer.size() - read));
+        size_t q = quote ? quote - data : buffer.size();
+
+        if (write != read) memmove(data + write, data + read, q - read);
+        write += q - read;
+
+        if (q + 1 < buffer.size() && data[q + 1] == '"') {
+            data[write++] = '"';
+            read = q + 2;
+            continue;
+        }
+        read = q + 1;
+        break;
+    }
+
+    pos = read < buffer.size() ? read : buffer.size();
+    // Texto suelto después de la comilla de cierre (CSV mal formado): se conserva hasta el separador
+    while (pos < buffer.size() && buffer[pos] != ',' && buffer[pos] != '\n' && buffer[pos] != '\r') {
+        data[write++] = buffer[pos++];
+    }
+    return string_view(data + start, write - start);
+}
+
+int csvInt(string_view field) {
+    int value = 0;
+    from_chars(field.data(), field.data() + field.size(), value);
+    return value;
+}
+
+float csvFloat(string_view field) {
+    float value = 0.0f;
+    from_chars(field.data(), field.data() + field.size(), value);
+    return value;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Lector CSV (RFC 4180) que carga el archivo completo en un solo buffer y
+// devuelve los campos como string_view sobre ese buffer, sin reservar memoria
+// por campo. Los campos entre comillas pueden contener comas, saltos de línea
+// y comillas escapadas (""); estas se desescapan en el mismo buffer.
+class CsvReader {
+public:
+    bool open(const std::string& filename);
+
+    // Avanza a la siguiente fila y deja sus campos en fields; false al final del archivo.
+    // Las vistas son válidas mientras el lector siga vivo.
+    bool nextRow(std::vector<std::string_view>& fields);
+
+private:
+    std::string_view parseQuoted();
+    std::string_view parseUnquoted();
+
+    std::string buffer;
+    size_t pos = 0;
+};
+
+// Conversión de campos numéricos; devuelven 0 si el campo está vacío o no es un número
+int csvInt(std::string_view field);
+float csvFloat(std::string_view field);
@@ -0,0 +1,202 @@
+#include "DamageEngine.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "DamageKernel.hpp"
+
+using namespace std;
+
+bool DamageEngine::damageTerms(SpeciesId attacker, MoveId moveId, SpeciesId defender, int level,
+                               float& scale, float& base) const {
+    const SpeciesTable& s = *species;
+    const MoveData& m = (*moves)[moveId];
+
+    int A, D;
+    if (m.category == MoveCategory::Physical) {
+        A = s.attack[attacker];
+        D = s.defense[defender];
+    } else if (m.category == MoveCategory::Special) {
+        A = s.spAttack[attacker];
+        D = s.spDefense[defender];
+    } else {
+        return false;
+    }
+    return formula(attacker, moveId, defender, level, A, D, scale, base);
+}
+
+bool DamageEngine::damageTerms(const Combatant& attacker, MoveId moveId, const Combatant& defender,
+                               float& scale, float& base) const {
+    const MoveData& m = (*moves)[moveId];
+
+    int A, D;
+    if (m.category == MoveCategory::Physical) {
+        A = attacker.stats.attack;
+        D = defender.stats.defense;
+    } else if (m.category == MoveCategory::Special) {
+        A = attacker.stats.spAttack;
+        D = defender.stats.spDefense;
+    } else {
+        return false;
+    }
+    return formula(attacker.species, moveId, defender.species, attacker.level, A, D, scale, base);
+}
+
+bool DamageEngine::formula(SpeciesId attacker, MoveId moveId, SpeciesId defender, int level, int A, int D,
+                           float& scale, float& base) const {
+    const SpeciesTable& s = *species;
+    const MoveData& m = (*moves)[moveId];
+    if (D <= 0) return false;
+
+    int N = level;
+    int P = m.power;
+    float B = (m.type == s.type1[attacker] || m.type == s.type2[attacker]) && m.type != PokeType::None ? 1.5f : 1.0f;
+    float E = chart->effectiveness(m.type, s.type1[defender], s.type2[defender]);
+
+    base = (((0.2f * N + 1) * A * P) / (25 * D)) + 2;
+    scale = 0.01f * B * E;
+    return true;
+}
+
+static DamageRange rangeOf(float scale, float base) {
+    float danioMin = scale * 85 * base;
+    float danioMax = scale * 100 * base;
+    return {floor(danioMin), floor(danioMax)};
+}
+
+DamageRange DamageEngine::compute(SpeciesId attacker, MoveId moveId, SpeciesId defender, int level) const {
+    float scale, base;
+    if (!damageTerms(attacker, moveId, defender, level, scale, base)) return {0.0f, 0.0f};
+    return rangeOf(scale, base);
+}
+
+DamageRange DamageEngine::compute(const Combatant& attacker, MoveId moveId, const Combatant& defender) const {
+    float scale, base;
+    if (!damageTerms(attacker, moveId, defender, scale, base)) return {0.0f, 0.0f};
+    return rangeOf(scale, base);
+}
+
+void DamageEngine::computeBatch(const DamageQuery* queries, size_t count, DamageRange* out) const {
+    for (size_t i = 0; i < count; ++i) {
+        const DamageQuery& q = queries[i];
+        out[i] = compute(q.attacker, q.move, q.defender, q.level);
+    }
+}
+
+void DamageEngine::sweepDefenders(const Combatant& attacker, MoveId moveId, const int16_t* defense,
+                                  const int16_t* spDefense, float* minOut, float* maxOut) const {
+    const SpeciesTable& s = *species;
+    const MoveData& m = (*moves)[moveId];
+    size_t count = s.size();
+
+    if (m.category == MoveCategory::Status) {
+        fill(minOut, minOut + count, 0.0f);
+        fill(maxOut, maxOut + count, 0.0f);
+        return;
+    }
+
+    bool physical = m.category == MoveCategory::Physical;
+    int A = physical ? attacker.stats.attack : attacker.stats.spAttack;
+    SpeciesId a = attacker.species;
+    float B = (m.type == s.type1[a] || m.type == s.type2[a]) && m.type != PokeType::None ? 1.5f : 1.0f;
+
+    // Multiplicador de tipo de cada defensor, en un buffer reutilizado por hilo
+    thread_local vector<float> effectiveness;
+    effectiveness.resize(count);
+    for (size_t d = 0; d < count; ++d) {
+        effectiveness[d] = chart->effectiveness(m.type, s.type1[d], s.type2[d]);
+    }
+
+    DamageKernelArgs args;
+    args.attackTerm = (0.2f * attacker.level + 1) * A * m.power;
+    args.scale = 0.01f * B;
+    args.defense = physical ? defense : spDefense;
+    args.effectiveness = effectiveness.data();
+    args.minOut = minOut;
+    args.maxOut = maxOut;
+    args.count = count;
+    runDamageKernel(args);
+}
+
+// Probabilidad de crítico por nivel de crit (0, 1, 2, 3+), como fracción exacta
+static const uint32_t critChance[4][2] = {{1, 16}, {1, 8}, {1, 2}, {1, 1}};
+static const float kCritMultiplier = 1.5f;
+
+static DamageDistribution emptyDistribution(const MoveData& m) {
+    DamageDistribution dist = {};
+    const uint32_t* chance = critChance[min<int>(m.crit, 3)];
+    dist.critNumerator = chance[0];
+    dist.critDenominator = chance[1];
+    return dist;
+}
+
+static void fillRolls(DamageDistribution& dist, float scale, float base) {
+    for (int r = 0; r < kDamageRolls; ++r) {
+        float roll = scale * (85 + r) * base;
+        dist.rolls[r] = static_cast<uint16_t>(min(floor(roll), 65535.0f));
+        dist.critRolls[r] = static_cast<uint16_t>(min(floor(roll * kCritMultiplier), 65535.0f));
+    }
+}
+
+DamageDistribution DamageEngine::distribution(SpeciesId attacker, MoveId moveId, SpeciesId defender, int level) const {
+    DamageDistribution dist = emptyDistribution((*moves)[moveId]);
+    float scale, base;
+    if (damageTerms(attacker, moveId, defender, level, scale, base)) fillRolls(dist, scale, base);
+    return dist;
+}
+
+DamageDistribution DamageEngine::distribution(const Combatant& attacker, MoveId moveId, const Combatant& defender) const {
+    DamageDistribution dist = emptyDistribution((*moves)[moveId]);
+    float scale, base;
+    if (damageTerms(attacker, moveId, defender, scale, base)) fillRolls(dist, scale, base);
+    return dist;
+}
+
+KoChances DamageEngine::koChances(SpeciesId attacker, MoveId moveId, SpeciesId defender, int level) const {
+    return koChances(distribution(attacker, moveId, defender, level), species->hp[defender]);
+}
+
+KoChances DamageEngine::koChances(const Combatant& attacker, MoveId moveId, const Combatant& defender) const {
+    return koChances(distribution(attacker, moveId, defender), defender.stats.hp);
+}
+
+KoChances DamageEngine::koChances(const DamageDistribution& hit, int hp) {
+    if (hp <= 0) return {1.0, 1.0, 1.0};
+
+    // Histograma de un golpe: daño (truncado en hp) -> peso entero.
+    // Cada tirada pesa (den - num) sin crítico y num con crítico; total 16 * den
+    vector<uint64_t> single(hp + 1, 0);
+    uint64_t nonCrit = hit.critDenominator - hit.critNumerator;
+    for (int r = 0; r < kDamageRolls; ++r) {
+        single[min<int>(hit.rolls[r], hp)] += nonCrit;
+        single[min<int>(hit.critRolls[r], hp)] += hit.critNumerator;
+    }
+    uint64_t perHit = uint64_t(kDamageRolls) * hit.critDenominator;
+
+    vector<pair<int, uint64_t>> outcomes;
+    for (int dmg = 0; dmg <= hp; ++dmg) {
+        if (single[dmg]) outcomes.emplace_back(dmg, single[dmg]);
+    }
+
+    // Daño acumulado tras cada golpe; la última casilla absorbe todo lo que debilita
+    vector<uint64_t> current(hp + 1, 0), next(hp + 1);
+    current[0] = 1;
+    uint64_t total = 1;
+    double chances[3];
+
+    for (int hitIndex = 0; hitIndex < 3; ++hitIndex) {
+        fill(next.begin(), next.end(), 0);
+        next[hp] = current[hp] * perHit;
+        for (int dealt = 0; dealt < hp; ++dealt) {
+            if (!current[dealt]) continue;
+            for (const auto& outcome : outcomes) {
+                next[min(dealt + outcome.first, hp)] += current[dealt] * outcome.second;
+            }
+        }
+        swap(current, next);
+        total *= perHit;
+        chances[hitIndex] = double(current[hp]) / double(total);
+    }
+    return {chances[0], chances[1], chances[2]};
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "MoveTable.hpp"
+#include "SpeciesTable.hpp"
+#include "StatCalc.hpp"
+#include "TypeChart.hpp"
+
+struct DamageQuery {
+    SpeciesId attacker;
+    MoveId move;
+    SpeciesId defender;
+    uint16_t level;
+};
+
+struct DamageRange {
+    float minDamage;
+    float maxDamage;
+};
+
+constexpr int kDamageRolls = 16;   // Tiradas 85..100
+
+// Daño de cada tirada con y sin crítico, y la probabilidad de crítico
+// (critNumerator / critDenominator) según el nivel de crit de moves.csv
+struct DamageDistribution {
+    uint16_t rolls[kDamageRolls];
+    uint16_t critRolls[kDamageRolls];
+    uint32_t critNumerator;
+    uint32_t critDenominator;
+};
+
+// Probabilidad exacta de debilitar en 1, 2 o 3 golpes (acumulada)
+struct KoChances {
+    double ohko;
+    double twoHko;
+    double threeHko;
+};
+
+// Motor de daño sin dependencias de SFML. Trabaja con IDs densos de especie
+// y movimiento, de modo que puede usarse desde la GUI o desde scripts.
+class DamageEngine {
+public:
+    DamageEngine(const TypeChart& chart, const SpeciesTable& species, const MoveTable& moves)
+        : chart(&chart), species(&species), moves(&moves) {}
+
+    // -1 si el nombre no está registrado
+    int findSpecies(const std::string& name) const { return species->find(name); }
+    int findMove(const std::string& name) const { return moves->find(name); }
+
+    const SpeciesTable& speciesTable() const { return *species; }
+    const MoveTable& moveTable() const { return *moves; }
+    const TypeChart& typeChart() const { return *chart; }
+    const MoveData& move(MoveId id) const { return (*moves)[id]; }
+    size_t speciesCount() const { return species->size(); }
+    size_t moveCount() const { return moves->size(); }
+
+    // Daño con las tiradas 85 y 100; {0, 0} para movimientos de estado
+    DamageRange compute(SpeciesId attacker, MoveId move, SpeciesId defender, int level) const;
+
+    // Rellena out[0..count) con el resultado de cada consulta
+    void computeBatch(const DamageQuery* queries, size_t count, DamageRange* out) const;
+
+    // Las 16 tiradas de un golpe, con y sin crítico
+    DamageDistribution distribution(SpeciesId attacker, MoveId move, SpeciesId defender, int level) const;
+
+    // KO contra los PS base del defensor (pokemon.csv)
+    KoChances koChances(SpeciesId attacker, MoveId move, SpeciesId defender, int level) const;
+
+    // Convoluciona la distribución de un golpe con histogramas enteros truncados en hp
+    static KoChances koChances(const DamageDistribution& hit, int hp);
+
+    // Lo mismo con estadísticas reales (StatCalc) en lugar de las base de pokemon.csv;
+    // cada lado usa su propio nivel y el KO se mide contra los PS reales del defensor
+    DamageRange compute(const Combatant& attacker, MoveId move, const Combatant& defender) const;
+    DamageDistribution distribution(const Combatant& attacker, MoveId move, const Combatant& defender) const;
+    KoChances koChances(const Combatant& attacker, MoveId move, const Combatant& defender) const;
+
+    // Un atacante y movimiento contra todas las especies de la tabla, con el kernel
+    // vectorizado. defense y spDefense son las estadísticas reales de cada defensor
+    // (p. ej. de StatCalc al nivel elegido); todos los arrays tienen speciesCount()
+    // elementos, indexados por SpeciesId
+    void sweepDefenders(const Combatant& attacker, MoveId move, const int16_t* defense, const int16_t* spDefense,
+                        float* minOut, float* maxOut) const;
+
+private:
+    // Parte común de la fórmula: daño = floor(scale * tirada * base).
+    // false para movimientos de estado o defensa nula
+    bool damageTerms(SpeciesId attacker, MoveId move, SpeciesId defender, int level,
+                     float& scale, float& base) const;
+    bool damageTerms(const Combatant& attacker, MoveId move, const Combatant& defender,
+                     float& scale, float& base) const;
+
+    // A y D ya elegidos según la categoría del movimiento
+    bool formula(SpeciesId attacker, MoveId move, SpeciesId defender, int level, int A, int D,
+                 float& scale, float& base) const;
+
+    const TypeChart* chart;
+    const SpeciesTable* species;
+    const MoveTable* moves;
+};
@@ -0,0 +1,105 @@
+#include "DamageKernel.hpp"
+
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DAMAGE_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Mismo orden de operaciones que DamageEngine::compute para obtener resultados idénticos
+static void scalarRange(const DamageKernelArgs& a, size_t begin) {
+    for (size_t i = begin; i < a.count; ++i) {
+        int D = a.defense[i];
+        if (D <= 0) {
+            a.minOut[i] = a.maxOut[i] = 0.0f;
+            continue;
+        }
+        float base = a.attackTerm / (25 * D) + 2;
+        float kE = a.scale * a.effectiveness[i];
+        a.minOut[i] = floor(kE * 85 * base);
+        a.maxOut[i] = floor(kE * 100 * base);
+    }
+}
+
+static void kernelScalar(const DamageKernelArgs& a) {
+    scalarRange(a, 0);
+}
+
+#ifdef DAMAGE_KERNEL_X86
+__attribute__((target("sse4.1")))
+static void kernelSse41(const DamageKernelArgs& a) {
+    const __m128 atk = _mm_set1_ps(a.attackTerm);
+    const __m128 scale = _mm_set1_ps(a.scale);
+    const __m128 k25 = _mm_set1_ps(25.0f), k2 = _mm_set1_ps(2.0f);
+    const __m128 k85 = _mm_set1_ps(85.0f), k100 = _mm_set1_ps(100.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 4 <= a.count; i += 4) {
+        __m128i d16 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(a.defense + i));
+        __m128 d = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(d16));
+        __m128 valid = _mm_cmpgt_ps(d, zero);
+
+        __m128 base = _mm_add_ps(_mm_div_ps(atk, _mm_mul_ps(d, k25)), k2);
+        __m128 kE = _mm_mul_ps(scale, _mm_loadu_ps(a.effectiveness + i));
+        __m128 mn = _mm_floor_ps(_mm_mul_ps(_mm_mul_ps(kE, k85), base));
+        __m128 mx = _mm_floor_ps(_mm_mul_ps(_mm_mul_ps(kE, k100), base));
+
+        _mm_storeu_ps(a.minOut + i, _mm_and_ps(mn, valid));
+        _mm_storeu_ps(a.maxOut + i, _mm_and_ps(mx, valid));
+    }
+    scalarRange(a, i);
+}
+
+__attribute__((target("avx2")))
+static void kernelAvx2(const DamageKernelArgs& a) {
+    const __m256 atk = _mm256_set1_ps(a.attackTerm);
+    const __m256 scale = _mm256_set1_ps(a.scale);
+    const __m256 k25 = _mm256_set1_ps(25.0f), k2 = _mm256_set1_ps(2.0f);
+    const __m256 k85 = _mm256_set1_ps(85.0f), k100 = _mm256_set1_ps(100.0f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 8 <= a.count; i += 8) {
+        __m128i d16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a.defense + i));
+        __m256 d = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(d16));
+        __m256 valid = _mm256_cmp_ps(d, zero, _CMP_GT_OQ);
+
+        __m256 base = _mm256_add_ps(_mm256_div_ps(atk, _mm256_mul_ps(d, k25)), k2);
+        __m256 kE = _mm256_mul_ps(scale, _mm256_loadu_ps(a.effectiveness + i));
+        __m256 mn = _mm256_floor_ps(_mm256_mul_ps(_mm256_mul_ps(kE, k85), base));
+        __m256 mx = _mm256_floor_ps(_mm256_mul_ps(_mm256_mul_ps(kE, k100), base));
+
+        _mm256_storeu_ps(a.minOut + i, _mm256_and_ps(mn, valid));
+        _mm256_storeu_ps(a.maxOut + i, _mm256_and_ps(mx, valid));
+    }
+    scalarRange(a, i);
+}
+#endif
+
+struct KernelChoice {
+    void (*run)(const DamageKernelArgs&);
+    const char* name;
+};
+
+static KernelChoice selectKernel() {
+#ifdef DAMAGE_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return {kernelAvx2, "AVX2"};
+    if (__builtin_cpu_supports("sse4.1")) return {kernelSse41, "SSE4.1"};
+#endif
+    return {kernelScalar, "escalar"};
+}
+
+static const KernelChoice kernel = selectKernel();
+
+void runDamageKernel(const DamageKernelArgs& args) {
+    kernel.run(args);
+}
+
+const char* damageKernelName() {
+    return kernel.name;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Parámetros de un atacante y movimiento fijos contra muchos defensores
+struct DamageKernelArgs {
+    float attackTerm;             // (0.2 * N + 1) * A * P
+    float scale;                  // 0.01 * B (STAB)
+    const int16_t* defense;       // Def o SpD de cada defensor, contiguos
+    const float* effectiveness;   // Multiplicador de tipo de cada defensor
+    float* minOut;                // floor(daño) con tirada 85
+    float* maxOut;                // floor(daño) con tirada 100
+    size_t count;
+};
+
+// Aplica la fórmula de procesar() a count defensores. La implementación
+// (AVX2, SSE4.1 o escalar) se elige una vez en tiempo de ejecución según la CPU;
+// todas dan exactamente el mismo resultado que DamageEngine::compute.
+void runDamageKernel(const DamageKernelArgs& args);
+
+// Nombre de la implementación elegida, para diagnóstico
+const char* damageKernelName();
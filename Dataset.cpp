@@ -0,0 +1,175 @@
+#include "Dataset.hpp"
+#include "Learnsets.hpp"
+#include "MoveTable.hpp"
+#include "TypeChart.hpp"
+
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#ifdef _WIN32
+bool MappedFile::open(const string& filename) {
+    close();
+    HANDLE f = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(f, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(f);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(f);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(f);
+        return false;
+    }
+
+    fileHandle = f;
+    mappingHandle = mapping;
+    bytes = static_cast<const unsigned char*>(view);
+    length = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes) UnmapViewOfFile(bytes);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    bytes = nullptr;
+    length = 0;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+}
+#else
+bool MappedFile::open(const string& filename) {
+    close();
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+
+    bytes = static_cast<const unsigned char*>(view);
+    length = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes) munmap(const_cast<unsigned char*>(bytes), length);
+    bytes = nullptr;
+    length = 0;
+}
+#endif
+
+bool Dataset::sectionFits(DatasetSection s, size_t elementSize, size_t alignment) const {
+    return s.offset % alignment == 0 && s.offset <= file.size() && s.count <= (file.size() - s.offset) / elementSize;
+}
+
+bool Dataset::open(const string& filename) {
+    header = nullptr;
+    if (!file.open(filename)) return false;
+
+    if (file.size() < sizeof(DatasetHeader)) {
+        cerr << filename << ": archivo demasiado corto" << endl;
+        return false;
+    }
+
+    const DatasetHeader* h = reinterpret_cast<const DatasetHeader*>(file.data());
+    if (h->magic != kDatasetMagic || h->version != kDatasetVersion || h->fileSize != file.size()) {
+        cerr << filename << ": formato o versión no soportados, regenerar con compile_dataset" << endl;
+        return false;
+    }
+
+    if (!sectionFits(h->typeChart, sizeof(float) * kTypeSlots, alignof(float)) ||
+        !sectionFits(h->species, sizeof(DatasetSpecies), alignof(DatasetSpecies)) ||
+        !sectionFits(h->moves, sizeof(DatasetMove), alignof(DatasetMove)) ||
+        !sectionFits(h->pokedex, sizeof(DatasetPokedexEntry), alignof(DatasetPokedexEntry)) ||
+        !sectionFits(h->learnsetBits, sizeof(uint64_t), alignof(uint64_t)) ||
+        !sectionFits(h->learnEntries, sizeof(DatasetLearnEntry), alignof(DatasetLearnEntry)) ||
+        !sectionFits(h->learnOffsets, sizeof(uint32_t), alignof(uint32_t)) ||
+        !sectionFits(h->strings, 1, 1) ||
+        h->typeChart.count != kTypeSlots * kTypeSlots ||
+        h->learnsetBits.count != h->species.count * ((h->moves.count + 63) / 64) ||
+        h->learnOffsets.count != h->species.count + 1) {
+        cerr << filename << ": secciones fuera de rango o desalineadas" << endl;
+        return false;
+    }
+
+    if (!recordsValid(*h)) {
+        cerr << filename << ": registros corruptos, regenerar con compile_dataset" << endl;
+        return false;
+    }
+
+    header = h;
+    return true;
+}
+
+// Los enums se guardan como uint8_t; PokeType::None es el último valor válido
+static bool typeValid(uint8_t type) {
+    return type < kTypeSlots;
+}
+
+bool Dataset::recordsValid(const DatasetHeader& h) const {
+    const unsigned char* base = file.data();
+    auto stringFits = [&](DatasetString s) {
+        return s.offset <= h.strings.count && s.length <= h.strings.count - s.offset;
+    };
+
+    const DatasetSpecies* speciesIn = reinterpret_cast<const DatasetSpecies*>(base + h.species.offset);
+    for (size_t i = 0; i < h.species.count; ++i) {
+        const DatasetSpecies& r = speciesIn[i];
+        if (!stringFits(r.name) || !typeValid(r.type1) || !typeValid(r.type2)) return false;
+    }
+
+    const DatasetMove* movesIn = reinterpret_cast<const DatasetMove*>(base + h.moves.offset);
+    for (size_t i = 0; i < h.moves.count; ++i) {
+        const DatasetMove& r = movesIn[i];
+        if (!stringFits(r.name) || !typeValid(r.type) || r.category > (uint8_t)MoveCategory::Status) return false;
+    }
+
+    const DatasetPokedexEntry* pokedexIn = reinterpret_cast<const DatasetPokedexEntry*>(base + h.pokedex.offset);
+    for (size_t i = 0; i < h.pokedex.count; ++i) {
+        const DatasetPokedexEntry& r = pokedexIn[i];
+        if (!stringFits(r.name) || !typeValid(r.type1) || !typeValid(r.type2)) return false;
+    }
+
+    // Offsets de aprendizajes: empiezan en 0, no decrecen y terminan en learnEntries.count
+    const uint32_t* offsets = reinterpret_cast<const uint32_t*>(base + h.learnOffsets.offset);
+    if (offsets[0] != 0 || offsets[h.learnOffsets.count - 1] != h.learnEntries.count) return false;
+    for (size_t i = 1; i < h.learnOffsets.count; ++i) {
+        if (offsets[i] < offsets[i - 1]) return false;
+    }
+
+    const DatasetLearnEntry* learnIn = reinterpret_cast<const DatasetLearnEntry*>(base + h.learnEntries.offset);
+    for (size_t i = 0; i < h.learnEntries.count; ++i) {
+        if (learnIn[i].move >= h.moves.count || learnIn[i].method > (uint8_t)LearnMethod::Prevo) return false;
+    }
+    return true;
+}
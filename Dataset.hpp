@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Formato binario precompilado (pokemon.dat), generado por compile_dataset a
+// partir de los CSV. Todas las secciones son arreglos de registros de ancho
+// fijo; los nombres viven en un pool de strings y se referencian por offset.
+// El archivo se mapea en memoria y se valida una vez; las tablas del motor
+// (TypeChart, SpeciesTable, MoveTable, Learnsets) copian sus registros sin
+// parsear texto.
+
+constexpr uint32_t kDatasetMagic = 0x53444B50;   // "PKDS"
+constexpr uint32_t kDatasetVersion = 2;
+
+struct DatasetSection {
+    uint32_t offset;   // Bytes desde el inicio del archivo
+    uint32_t count;    // Número de elementos (bytes en el pool de strings)
+};
+
+struct DatasetString {
+    uint32_t offset;   // Bytes desde el inicio del pool
+    uint32_t length;
+};
+
+struct DatasetHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t fileSize;
+    uint32_t reserved;
+    DatasetSection typeChart;      // float[count][kTypeSlots], filas resueltas de TypeChart
+    DatasetSection species;        // DatasetSpecies, en orden de SpeciesId
+    DatasetSection moves;          // DatasetMove, en orden de MoveId
+    DatasetSection pokedex;        // DatasetPokedexEntry, ordenadas por nombre
+    DatasetSection learnsetBits;   // uint64_t[species.count][(moves.count + 63) / 64]
+    DatasetSection learnEntries;   // DatasetLearnEntry, agrupadas por especie
+    DatasetSection learnOffsets;   // uint32_t[species.count + 1], inicio de cada especie en learnEntries
+    DatasetSection strings;        // char
+};
+
+struct DatasetSpecies {
+    DatasetString name;
+    uint8_t type1;
+    uint8_t type2;
+    int16_t hp;
+    int16_t attack;
+    int16_t defense;
+    int16_t spAttack;
+    int16_t spDefense;
+    int16_t speed;
+    uint16_t padding;
+};
+
+struct DatasetMove {
+    DatasetString name;
+    uint8_t type;
+    uint8_t category;
+    uint8_t accuracy;
+    uint8_t crit;
+    int8_t priority;
+    uint8_t padding;
+    uint16_t power;
+};
+
+// Entrada de pokemon_data.csv: nombre mostrado en los dropdowns y sus tipos
+struct DatasetPokedexEntry {
+    DatasetString name;
+    uint8_t type1;
+    uint8_t type2;
+    uint16_t padding;
+};
+
+// Cómo aprende una especie un movimiento (movesets.csv)
+struct DatasetLearnEntry {
+    uint16_t move;
+    uint8_t method;    // LearnMethod
+    uint8_t level;
+};
+
+static_assert(sizeof(DatasetHeader) == 80, "DatasetHeader debe tener ancho fijo");
+static_assert(sizeof(DatasetSpecies) == 24, "DatasetSpecies debe tener ancho fijo");
+static_assert(sizeof(DatasetMove) == 16, "DatasetMove debe tener ancho fijo");
+static_assert(sizeof(DatasetPokedexEntry) == 12, "DatasetPokedexEntry debe tener ancho fijo");
+static_assert(sizeof(DatasetLearnEntry) == 4, "DatasetLearnEntry debe tener ancho fijo");
+
+// Archivo de solo lectura mapeado en memoria
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const std::string& filename);
+    void close();
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const unsigned char* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+// Vista de solo lectura sobre un pokemon.dat mapeado. Los punteros devueltos
+// apuntan al archivo y son válidos mientras el Dataset siga abierto.
+class Dataset {
+public:
+    // Valida magia, versión, que todas las secciones caigan dentro del archivo
+    // alineadas a su tipo y que los nombres, tipos, IDs y offsets de los
+    // registros apunten dentro de sus secciones; las tablas se pueden leer
+    // después sin más comprobaciones
+    bool open(const std::string& filename);
+    bool isOpen() const { return header != nullptr; }
+
+    const float* typeChartRows() const { return section<float>(header->typeChart); }
+    size_t typeChartRowCount() const { return header->typeChart.count; }
+
+    const DatasetSpecies* species() const { return section<DatasetSpecies>(header->species); }
+    size_t speciesCount() const { return header->species.count; }
+
+    const DatasetMove* moves() const { return section<DatasetMove>(header->moves); }
+    size_t moveCount() const { return header->moves.count; }
+
+    const DatasetPokedexEntry* pokedex() const { return section<DatasetPokedexEntry>(header->pokedex); }
+    size_t pokedexCount() const { return header->pokedex.count; }
+
+    const uint64_t* learnsetBits() const { return section<uint64_t>(header->learnsetBits); }
+    size_t learnsetBitCount() const { return header->learnsetBits.count; }
+
+    const DatasetLearnEntry* learnEntries() const { return section<DatasetLearnEntry>(header->learnEntries); }
+    size_t learnEntryCount() const { return header->learnEntries.count; }
+
+    const uint32_t* learnOffsets() const { return section<uint32_t>(header->learnOffsets); }
+    size_t learnOffsetCount() const { return header->learnOffsets.count; }
+
+    std::string_view str(DatasetString s) const {
+        return std::string_view(section<char>(header->strings) + s.offset, s.length);
+    }
+
+private:
+    template <typename T>
+    const T* section(DatasetSection s) const {
+        return reinterpret_cast<const T*>(file.data() + s.offset);
+    }
+
+    // Dentro del archivo y alineada para leerla como T*
+    bool sectionFits(DatasetSection s, size_t elementSize, size_t alignment) const;
+    bool recordsValid(const DatasetHeader& h) const;
+
+    MappedFile file;
+    const DatasetHeader* header = nullptr;
+};
@@ -0,0 +1,235 @@
+#include "Expectimax.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <map>
+
+using namespace std;
+
+namespace {
+
+// Daño posible de un movimiento con su probabilidad (fallo incluido como daño 0)
+struct Outcome {
+    int damage;
+    double probability;
+};
+
+struct SolverMove {
+    vector<Outcome> outcomes;
+    int8_t priority;
+    double expected;
+};
+
+struct SolverSide {
+    vector<SolverMove> moves;   // Vacío: el lado no puede dañar
+    vector<int> index;          // Posición de cada movimiento en BattleSide::moves
+    int speed;
+    double bestExpected = 0;
+};
+
+SolverSide prepare(const DamageEngine& engine, const BattleSide& self, const BattleSide& rival) {
+    SolverSide side;
+    side.speed = self.mon.stats.speed;
+    for (size_t i = 0; i < self.moves.size(); ++i) {
+        const MoveData& m = engine.move(self.moves[i]);
+        if (m.category == MoveCategory::Status || m.power == 0) continue;
+
+        DamageDistribution d = engine.distribution(self.mon, self.moves[i], rival.mon);
+        double hit = m.accuracy == 0 ? 1.0 : m.accuracy / 100.0;
+        double critP = double(d.critNumerator) / d.critDenominator;
+
+        map<int, double> merged;
+        if (hit < 1.0) merged[0] += 1.0 - hit;
+        for (int r = 0; r < kDamageRolls; ++r) {
+            merged[d.rolls[r]] += hit * (1 - critP) / kDamageRolls;
+            merged[d.critRolls[r]] += hit * critP / kDamageRolls;
+        }
+
+        SolverMove move{{}, m.priority, 0};
+        for (const auto& entry : merged) {
+            move.outcomes.push_back({entry.first, entry.second});
+            move.expected += entry.first * entry.second;
+        }
+        side.bestExpected = max(side.bestExpected, move.expected);
+        side.moves.push_back(move);
+        side.index.push_back(static_cast<int>(i));
+    }
+    return side;
+}
+
+struct Value {
+    double v;
+    bool exact;
+};
+
+struct TableEntry {
+    uint32_t key = 0xFFFFFFFF;
+    int16_t depth = -1;        // Profundidad con la que se calculó
+    bool exact = false;
+    float value = 0;
+};
+
+class Search {
+public:
+    Search(const SolverSide& a, const SolverSide& b, const SolverBudget& budget)
+        : a(a), b(b), budget(budget), table(kTableSize), start(chrono::steady_clock::now()) {}
+
+    // Mejor movimiento de A en la raíz y su valor
+    Value root(int hpA, int hpB, int depth, int& bestMove) {
+        bestMove = -1;
+        Value best{-1, true};
+        for (int i = 0; i < max<int>(1, a.moves.size()); ++i) {
+            Value worst = bestReply(i, hpA, hpB, depth, best.v);
+            if (worst.v > best.v) {
+                best = {worst.v, best.exact && worst.exact};
+                bestMove = a.moves.empty() ? -1 : i;
+            } else {
+                best.exact = best.exact && worst.exact;
+            }
+        }
+        return best;
+    }
+
+    uint64_t nodes = 0;
+    bool aborted = false;   // Presupuesto agotado: la iteración en curso no vale
+
+private:
+    static constexpr size_t kTableSize = 1 << 18;
+
+    Value search(int hpA, int hpB, int depth) {
+        if (aborted) return {0.5, false};
+        if (hpB <= 0) return {1, true};
+        if (hpA <= 0) return {0, true};
+        if (a.moves.empty() && b.moves.empty()) return {0.5, true};
+        if (depth == 0) return {heuristic(hpA, hpB), false};
+
+        uint32_t key = (uint32_t(hpA) << 16) | uint32_t(hpB);
+        TableEntry& entry = table[(key * 0x9E3779B1u) >> (32 - 18)];
+        if (entry.key == key && (entry.exact || entry.depth >= depth)) return {entry.value, entry.exact};
+
+        if (++nodes > budget.maxNodes ||
+            ((nodes & 1023) == 0 &&
+             chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() > budget.maxMillis)) {
+            aborted = true;
+            return {0.5, false};
+        }
+
+        Value best{-1, true};
+        for (int i = 0; i < max<int>(1, a.moves.size()); ++i) {
+            Value worst = bestReply(i, hpA, hpB, depth, best.v);
+            best.exact = best.exact && worst.exact;
+            best.v = max(best.v, worst.v);
+        }
+
+        if (aborted) return best;
+        if (entry.key != key || depth >= entry.depth || best.exact) {
+            entry.key = key;
+            entry.depth = static_cast<int16_t>(depth);
+            entry.exact = best.exact;
+            entry.value = static_cast<float>(best.v);
+        }
+        return best;
+    }
+
+    // Respuesta de B que minimiza el valor del movimiento i de A. Si ya cae por
+    // debajo de alpha (lo que A consigue con otro movimiento) se deja de buscar
+    Value bestReply(int i, int hpA, int hpB, int depth, double alpha) {
+        Value worst{2, true};
+        for (int j = 0; j < max<int>(1, b.moves.size()); ++j) {
+            Value v = expect(i, j, hpA, hpB, depth);
+            worst.exact = worst.exact && v.exact;
+            worst.v = min(worst.v, v.v);
+            if (worst.v <= alpha) break;
+        }
+        return worst;
+    }
+
+    // Valor esperado de un turno en el que A usa i y B usa j
+    Value expect(int i, int j, int hpA, int hpB, int depth) {
+        const SolverMove* moveA = a.moves.empty() ? nullptr : &a.moves[i];
+        const SolverMove* moveB = b.moves.empty() ? nullptr : &b.moves[j];
+
+        int priorityA = moveA ? moveA->priority : 0;
+        int priorityB = moveB ? moveB->priority : 0;
+        double aFirst;
+        if (priorityA != priorityB) aFirst = priorityA > priorityB ? 1 : 0;
+        else if (a.speed != b.speed) aFirst = a.speed > b.speed ? 1 : 0;
+        else aFirst = 0.5;
+
+        Value total{0, true};
+        if (aFirst > 0) accumulate(total, aFirst, moveA, moveB, hpA, hpB, depth, true);
+        if (aFirst < 1) accumulate(total, 1 - aFirst, moveB, moveA, hpB, hpA, depth, false);
+        return total;
+    }
+
+    // first ataca antes que second; hpFirst/hpSecond son los PS de cada uno
+    void accumulate(Value& total, double weight, const SolverMove* first, const SolverMove* second,
+                    int hpFirst, int hpSecond, int depth, bool firstIsA) {
+        static const vector<Outcome> nothing = {{0, 1.0}};
+        const vector<Outcome>& firstOutcomes = first ? first->outcomes : nothing;
+        const vector<Outcome>& secondOutcomes = second ? second->outcomes : nothing;
+
+        for (const Outcome& o1 : firstOutcomes) {
+            int secondLeft = hpSecond - o1.damage;
+            if (secondLeft <= 0) {
+                total.v += weight * o1.probability * (firstIsA ? 1 : 0);
+                continue;
+            }
+            for (const Outcome& o2 : secondOutcomes) {
+                int firstLeft = hpFirst - o2.damage;
+                double p = weight * o1.probability * o2.probability;
+                if (firstLeft <= 0) {
+                    total.v += p * (firstIsA ? 0 : 1);
+                    continue;
+                }
+                Value child = firstIsA ? search(firstLeft, secondLeft, depth - 1)
+                                       : search(secondLeft, firstLeft, depth - 1);
+                total.v += p * child.v;
+                total.exact = total.exact && child.exact;
+            }
+        }
+    }
+
+    // Turnos que necesita cada lado para debilitar al otro con su mejor daño esperado
+    double heuristic(int hpA, int hpB) const {
+        double turnsA = a.bestExpected > 0 ? hpB / a.bestExpected : numeric_limits<double>::infinity();
+        double turnsB = b.bestExpected > 0 ? hpA / b.bestExpected : numeric_limits<double>::infinity();
+        if (turnsA == turnsB) return 0.5;
+        if (turnsB == numeric_limits<double>::infinity()) return 1;
+        if (turnsA == numeric_limits<double>::infinity()) return 0;
+        return turnsB / (turnsA + turnsB);
+    }
+
+    const SolverSide& a;
+    const SolverSide& b;
+    const SolverBudget& budget;
+    vector<TableEntry> table;
+    chrono::steady_clock::time_point start;
+};
+
+}
+
+SolverResult ExpectimaxSolver::solve(const BattleSide& a, const BattleSide& b, const SolverBudget& budget,
+                                     int hpA, int hpB) const {
+    SolverSide sideA = prepare(*engine, a, b);
+    SolverSide sideB = prepare(*engine, b, a);
+    if (hpA < 0) hpA = a.mon.stats.hp;
+    if (hpB < 0) hpB = b.mon.stats.hp;
+
+    SolverResult result = {0.5, -1, 0, false, 0};
+    Search search(sideA, sideB, budget);
+
+    for (int depth = 1; depth <= budget.maxDepth; ++depth) {
+        int bestMove;
+        Value value = search.root(hpA, hpB, depth, bestMove);
+        if (search.aborted) break;
+        result.winProbability = value.v;
+        result.bestMove = bestMove < 0 ? -1 : sideA.index[bestMove];
+        result.depth = depth;
+        result.exact = value.exact;
+        if (value.exact) break;
+    }
+    result.nodes = search.nodes;
+    return result;
+}
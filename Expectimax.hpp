@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BattleSim.hpp"
+#include "DamageEngine.hpp"
+
+// Límites de una búsqueda; la profundidad va en turnos completos
+struct SolverBudget {
+    uint64_t maxNodes = 2000000;
+    double maxMillis = 100;
+    int maxDepth = 32;
+};
+
+struct SolverResult {
+    double winProbability;   // De A, con el mejor movimiento
+    int bestMove;            // Índice en BattleSide::moves de A; -1 si no tiene ataques
+    int depth;               // Última profundidad completada
+    bool exact;              // Ninguna hoja usó la heurística: es la probabilidad exacta
+    uint64_t nodes;
+};
+
+// Resuelve combates 1 contra 1 cortos de forma exacta. En cada turno A elige
+// el movimiento que maximiza su probabilidad de ganar suponiendo que B responde
+// con el que la minimiza; el orden (prioridad, velocidad, empate 50%), la
+// precisión, el crítico y las 16 tiradas se expanden como nodos de azar, con
+// los daños iguales agrupados. Las posiciones se guardan en una tabla de
+// transposición indexada por (PS de A, PS de B) con la profundidad restante.
+//
+// La búsqueda se profundiza de un turno en uno hasta que el resultado es exacto
+// o se agota el presupuesto; se devuelve la última iteración completa. Las
+// hojas a profundidad 0 se estiman con los turnos que necesita cada lado para
+// debilitar al otro.
+class ExpectimaxSolver {
+public:
+    explicit ExpectimaxSolver(const DamageEngine& engine) : engine(&engine) {}
+
+    // hpA/hpB: PS actuales (-1 = completos), para resolver finales de combate
+    SolverResult solve(const BattleSide& a, const BattleSide& b, const SolverBudget& budget = SolverBudget(),
+                       int hpA = -1, int hpB = -1) const;
+
+private:
+    const DamageEngine* engine;
+};
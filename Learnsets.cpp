@@ -0,0 +1,110 @@
+#include "Learnsets.hpp"
+#include "Dataset.hpp"
+
+#include <iostream>
+
+#include "CsvReader.hpp"
+
+using namespace std;
+
+LearnMethod parseLearnMethod(string_view prefix, int& level) {
+    level = 0;
+    if (prefix.size() > 1 && prefix[0] == 'L' && prefix[1] >= '0' && prefix[1] <= '9') {
+        level = csvInt(prefix.substr(1));
+        return LearnMethod::Level;
+    }
+    if (prefix.substr(0, 2) == "TM" || prefix.substr(0, 2) == "HM") return LearnMethod::Machine;
+    if (prefix.substr(0, 3) == "Egg") return LearnMethod::Egg;
+    if (prefix == "Tutor" || prefix == "ORAS") return LearnMethod::Tutor;
+    if (prefix == "Prev") return LearnMethod::Prevo;
+    return LearnMethod::Start;
+}
+
+void Learnsets::reset(size_t speciesCount, size_t moveCount) {
+    words = (moveCount + 63) / 64;
+    bitsets.assign(speciesCount * words, 0);
+    entries.clear();
+    entryOffsets.assign(speciesCount + 1, 0);
+}
+
+void Learnsets::buildIndexes(size_t moveCount) {
+    learners.assign(moveCount, {});
+    size_t speciesCount = entryOffsets.size() - 1;
+    for (size_t sp = 0; sp < speciesCount; ++sp) {
+        for (size_t m = 0; m < moveCount; ++m) {
+            if (canLearn(static_cast<SpeciesId>(sp), static_cast<MoveId>(m))) {
+                learners[m].push_back(static_cast<SpeciesId>(sp));
+            }
+        }
+    }
+}
+
+bool Learnsets::loadFromCsv(const string& filename, const SpeciesTable& species, const MoveTable& moves) {
+    CsvReader csv;
+    if (!csv.open(filename)) {
+        cerr << "Error al abrir " << filename << endl;
+        return false;
+    }
+
+    reset(species.size(), moves.size());
+    vector<vector<LearnEntry>> perSpecies(species.size());
+    vector<bool> seen(species.size(), false);
+
+    vector<string_view> fields;
+    csv.nextRow(fields); // ndex,species,forme,move1..move174
+
+    while (csv.nextRow(fields)) {
+        if (fields.size() < 3) continue;
+
+        // Las formas alternativas repiten la especie; se queda la primera fila (forma base)
+        int sp = species.find(string(fields[1]));
+        if (sp < 0 || seen[sp]) continue;
+        seen[sp] = true;
+
+        for (size_t i = 3; i < fields.size(); ++i) {
+            // "L13 - Poison Powder"
+            string_view field = fields[i];
+            size_t dash = field.find(" - ");
+            if (dash == string_view::npos) continue;
+
+            int move = moves.find(string(field.substr(dash + 3)));
+            if (move < 0) continue;
+
+            int level;
+            LearnMethod method = parseLearnMethod(field.substr(0, dash), level);
+            perSpecies[sp].push_back({static_cast<MoveId>(move), method, static_cast<uint8_t>(level)});
+            bitsets[sp * words + move / 64] |= uint64_t(1) << (move % 64);
+        }
+    }
+
+    for (size_t sp = 0; sp < perSpecies.size(); ++sp) {
+        entries.insert(entries.end(), perSpecies[sp].begin(), perSpecies[sp].end());
+        entryOffsets[sp + 1] = static_cast<uint32_t>(entries.size());
+    }
+    buildIndexes(moves.size());
+    return true;
+}
+
+bool Learnsets::loadFromDataset(const Dataset& dataset, size_t speciesCount, size_t moveCount) {
+    reset(speciesCount, moveCount);
+    if (dataset.learnsetBitCount() != bitsets.size() ||
+        dataset.learnOffsetCount() != entryOffsets.size()) {
+        return false;
+    }
+
+    const uint64_t* bitsIn = dataset.learnsetBits();
+    bitsets.assign(bitsIn, bitsIn + bitsets.size());
+
+    const uint32_t* offsetsIn = dataset.learnOffsets();
+    entryOffsets.assign(offsetsIn, offsetsIn + entryOffsets.size());
+
+    const DatasetLearnEntry* entriesIn = dataset.learnEntries();
+    entries.reserve(dataset.learnEntryCount());
+    for (size_t i = 0; i < dataset.learnEntryCount(); ++i) {
+        entries.push_back({entriesIn[i].move, static_cast<LearnMethod>(entriesIn[i].method), entriesIn[i].level});
+    }
+    if (entryOffsets.back() != entries.size()) return false;
+
+    buildIndexes(moveCount);
+    return true;
+}
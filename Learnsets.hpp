@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "MoveTable.hpp"
+#include "SpeciesTable.hpp"
+
+class Dataset;
+
+enum class LearnMethod : uint8_t { Start, Level, Machine, Egg, Tutor, Prevo };
+
+// "L13" -> Level (nivel 13), "TM06" -> Machine, "Egg*" -> Egg...
+LearnMethod parseLearnMethod(std::string_view prefix, int& level);
+
+struct LearnEntry {
+    MoveId move;
+    LearnMethod method;
+    uint8_t level;   // Solo para LearnMethod::Level
+};
+
+// Movimientos legales por especie (movesets.csv). Cada especie tiene un bitset
+// sobre el MoveId denso, guardado de forma contigua, y hay un índice inverso
+// movimiento -> especies. Intersecar con una máscara de movimientos es un AND
+// por palabra.
+class Learnsets {
+public:
+    bool loadFromCsv(const std::string& filename, const SpeciesTable& species, const MoveTable& moves);
+    bool loadFromDataset(const Dataset& dataset, size_t speciesCount, size_t moveCount);
+
+    size_t wordsPerSpecies() const { return words; }
+
+    // Bitset de la especie: wordsPerSpecies() palabras de 64 bits
+    const uint64_t* bits(SpeciesId species) const { return &bitsets[species * words]; }
+
+    bool hasData(SpeciesId species) const { return species + 1u < entryOffsets.size() && !entriesOf(species).empty(); }
+
+    bool canLearn(SpeciesId species, MoveId move) const {
+        return (bits(species)[move / 64] >> (move % 64)) & 1;
+    }
+
+    // Cómo aprende cada movimiento (puede repetir un movimiento con varios métodos)
+    struct EntryRange {
+        const LearnEntry* first;
+        const LearnEntry* last;
+        const LearnEntry* begin() const { return first; }
+        const LearnEntry* end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+    EntryRange entriesOf(SpeciesId species) const {
+        return {entries.data() + entryOffsets[species], entries.data() + entryOffsets[species + 1]};
+    }
+
+    const std::vector<SpeciesId>& learnersOf(MoveId move) const { return learners[move]; }
+
+    // Máscara con los movimientos que cumplen pred, para combinarla con bits()
+    template <typename Pred>
+    static std::vector<uint64_t> moveMask(const MoveTable& moves, Pred pred) {
+        std::vector<uint64_t> mask((moves.size() + 63) / 64, 0);
+        for (size_t m = 0; m < moves.size(); ++m) {
+            if (pred(moves[static_cast<MoveId>(m)])) mask[m / 64] |= uint64_t(1) << (m % 64);
+        }
+        return mask;
+    }
+
+    // Llama a fn(MoveId) por cada movimiento legal de la especie que también esté en mask
+    template <typename Fn>
+    void forEachMove(SpeciesId species, const uint64_t* mask, Fn fn) const {
+        const uint64_t* b = bits(species);
+        for (size_t w = 0; w < words; ++w) {
+            uint64_t word = b[w] & mask[w];
+            while (word) {
+                int bit = __builtin_ctzll(word);
+                fn(static_cast<MoveId>(w * 64 + bit));
+                word &= word - 1;
+            }
+        }
+    }
+
+    // Datos crudos, para compile_dataset
+    const std::vector<uint64_t>& allBits() const { return bitsets; }
+    const std::vector<LearnEntry>& allEntries() const { return entries; }
+    const std::vector<uint32_t>& offsets() const { return entryOffsets; }
+
+private:
+    void reset(size_t speciesCount, size_t moveCount);
+    void buildIndexes(size_t moveCount);
+
+    size_t words = 0;
+    std::vector<uint64_t> bitsets;               // speciesCount * words
+    std::vector<LearnEntry> entries;             // Agrupadas por especie
+    std::vector<uint32_t> entryOffsets;          // speciesCount + 1
+    std::vector<std::vector<SpeciesId>> learners;
+};
@@ -0,0 +1,76 @@
+#include "MoveTable.hpp"
+#include "Dataset.hpp"
+
+#include <iostream>
+
+#include "CsvReader.hpp"
+
+using namespace std;
+
+MoveCategory parseCategory(string_view name) {
+    if (name == "Physical") return MoveCategory::Physical;
+    if (name == "Special") return MoveCategory::Special;
+    return MoveCategory::Status;
+}
+
+const char* categoryName(MoveCategory category) {
+    switch (category) {
+        case MoveCategory::Physical: return "Physical";
+        case MoveCategory::Special: return "Special";
+        default: return "Status";
+    }
+}
+
+MoveId MoveTable::add(const MoveData& data) {
+    auto it = index.find(data.name);
+    if (it != index.end()) return it->second;
+
+    MoveId id = static_cast<MoveId>(moves.size());
+    index[data.name] = id;
+    moves.push_back(data);
+    return id;
+}
+
+bool MoveTable::loadFromCsv(const string& filename) {
+    CsvReader csv;
+    if (!csv.open(filename)) {
+        cerr << "Error al abrir el archivo " << filename << endl;
+        return false;
+    }
+
+    vector<string_view> fields;
+    csv.nextRow(fields); // Read header
+
+    // id,name,type,category,power,accuracy,priority,crit
+    while (csv.nextRow(fields)) {
+        if (fields.size() < 8) continue;
+
+        MoveData m;
+        m.name = string(fields[1]);
+        m.type = parseType(fields[2]);
+        m.category = parseCategory(fields[3]);
+        m.power = csvInt(fields[4]);
+        m.accuracy = csvInt(fields[5]);
+        m.priority = csvInt(fields[6]);
+        m.crit = csvInt(fields[7]);
+        add(m);
+    }
+    return true;
+}
+
+bool MoveTable::loadFromDataset(const Dataset& dataset) {
+    const DatasetMove* records = dataset.moves();
+    for (size_t i = 0; i < dataset.moveCount(); ++i) {
+        const DatasetMove& r = records[i];
+        MoveData m;
+        m.name = string(dataset.str(r.name));
+        m.type = static_cast<PokeType>(r.type);
+        m.category = static_cast<MoveCategory>(r.category);
+        m.power = r.power;
+        m.accuracy = r.accuracy;
+        m.priority = r.priority;
+        m.crit = r.crit;
+        add(m);
+    }
+    return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "TypeChart.hpp"
+
+class Dataset;
+
+using MoveId = uint16_t;
+
+enum class MoveCategory : uint8_t { Physical, Special, Status };
+
+MoveCategory parseCategory(std::string_view name);
+const char* categoryName(MoveCategory category);
+
+// Datos numéricos de un movimiento, ya convertidos desde moves.csv
+struct MoveData {
+    std::string name;
+    PokeType type = PokeType::None;
+    MoveCategory category = MoveCategory::Status;
+    uint16_t power = 0;
+    uint8_t accuracy = 0;
+    int8_t priority = 0;
+    uint8_t crit = 0;
+};
+
+// Movimientos guardados de forma contigua; el índice en la tabla es el MoveId
+class MoveTable {
+public:
+    bool loadFromCsv(const std::string& filename);
+    bool loadFromDataset(const Dataset& dataset);
+
+    // Registra un movimiento y devuelve su ID; si el nombre ya existe devuelve el existente
+    MoveId add(const MoveData& data);
+
+    // -1 si no existe un movimiento con ese nombre
+    int find(const std::string& name) const {
+        auto it = index.find(name);
+        return it == index.end() ? -1 : it->second;
+    }
+
+    size_t size() const { return moves.size(); }
+    const MoveData& operator[](MoveId id) const { return moves[id]; }
+    std::vector<MoveData>::const_iterator begin() const { return moves.begin(); }
+    std::vector<MoveData>::const_iterator end() const { return moves.end(); }
+
+private:
+    std::vector<MoveData> moves;
+    std::unordered_map<std::string, MoveId> index;
+};
@@ -0,0 +1,78 @@
+#include "SpeciesTable.hpp"
+#include "Dataset.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include "CsvReader.hpp"
+
+using namespace std;
+
+SpeciesId SpeciesTable::add(const string& name, PokeType t1, PokeType t2,
+                            int hpValue, int atk, int def, int spa, int spd, int spe) {
+    auto it = index.find(name);
+    if (it != index.end()) return it->second;
+
+    SpeciesId id = static_cast<SpeciesId>(names.size());
+    index[name] = id;
+    names.push_back(name);
+    type1.push_back(t1);
+    type2.push_back(t2);
+    hp.push_back(static_cast<int16_t>(hpValue));
+    attack.push_back(static_cast<int16_t>(atk));
+    defense.push_back(static_cast<int16_t>(def));
+    spAttack.push_back(static_cast<int16_t>(spa));
+    spDefense.push_back(static_cast<int16_t>(spd));
+    speed.push_back(static_cast<int16_t>(spe));
+    return id;
+}
+
+bool SpeciesTable::loadFromCsv(const string& filename) {
+    CsvReader csv;
+    if (!csv.open(filename)) {
+        cerr << "Error al abrir " << filename << endl;
+        return false;
+    }
+
+    vector<string_view> fields;
+    csv.nextRow(fields);
+
+    // Columnas por nombre de cabecera, para no depender de su posición
+    unordered_map<string, size_t> column;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        column[string(fields[i])] = i;
+    }
+    const char* required[] = {"species", "type1", "type2", "hp", "attack",
+                              "defense", "spattack", "spdefense", "speed"};
+    size_t lastColumn = 0;
+    for (const char* name : required) {
+        if (!column.count(name)) {
+            cerr << "Falta la columna " << name << " en " << filename << endl;
+            return false;
+        }
+        lastColumn = max(lastColumn, column[name]);
+    }
+    size_t cSpecies = column["species"], cType1 = column["type1"], cType2 = column["type2"];
+    size_t cHp = column["hp"], cAtk = column["attack"], cDef = column["defense"];
+    size_t cSpa = column["spattack"], cSpd = column["spdefense"], cSpe = column["speed"];
+
+    while (csv.nextRow(fields)) {
+        if (fields.size() <= lastColumn) continue;
+
+        // Las formas alternativas repiten el nombre de especie; se queda la forma base
+        add(string(fields[cSpecies]), parseType(fields[cType1]), parseType(fields[cType2]),
+            csvInt(fields[cHp]), csvInt(fields[cAtk]), csvInt(fields[cDef]),
+            csvInt(fields[cSpa]), csvInt(fields[cSpd]), csvInt(fields[cSpe]));
+    }
+    return true;
+}
+
+bool SpeciesTable::loadFromDataset(const Dataset& dataset) {
+    const DatasetSpecies* records = dataset.species();
+    for (size_t i = 0; i < dataset.speciesCount(); ++i) {
+        const DatasetSpecies& r = records[i];
+        add(string(dataset.str(r.name)), static_cast<PokeType>(r.type1), static_cast<PokeType>(r.type2),
+            r.hp, r.attack, r.defense, r.spAttack, r.spDefense, r.speed);
+    }
+    return true;
+}
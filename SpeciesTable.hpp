@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "TypeChart.hpp"
+
+class Dataset;
+
+using SpeciesId = uint16_t;
+
+// Tabla columnar de especies (pokemon.csv). Cada estadística vive en su propio
+// arreglo contiguo indexado por SpeciesId; los números se convierten al cargar.
+class SpeciesTable {
+public:
+    bool loadFromCsv(const std::string& filename);
+    bool loadFromDataset(const Dataset& dataset);
+
+    // Registra una especie y devuelve su ID; si el nombre ya existe devuelve el existente
+    SpeciesId add(const std::string& name, PokeType t1, PokeType t2,
+                  int hp, int atk, int def, int spa, int spd, int spe);
+
+    // -1 si el nombre no está registrado
+    int find(const std::string& name) const {
+        auto it = index.find(name);
+        return it == index.end() ? -1 : it->second;
+    }
+
+    size_t size() const { return names.size(); }
+
+    std::vector<std::string> names;
+    std::vector<PokeType> type1;
+    std::vector<PokeType> type2;
+    std::vector<int16_t> hp;
+    std::vector<int16_t> attack;
+    std::vector<int16_t> defense;
+    std::vector<int16_t> spAttack;
+    std::vector<int16_t> spDefense;
+    std::vector<int16_t> speed;
+
+private:
+    std::unordered_map<std::string, SpeciesId> index;
+};
@@ -0,0 +1,96 @@
+#include "SpriteIndex.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "CsvReader.hpp"
+
+using namespace std;
+
+unsigned spriteLevelFor(float displaySize) {
+    for (unsigned level : kSpriteLevels) {
+        if (level >= displaySize) return level;
+    }
+    return kSpriteLevels[size(kSpriteLevels) - 1];
+}
+
+string spriteKey(string_view name) {
+    string key;
+    bool separator = false;   // Hay que poner un '-' antes de la próxima letra
+    auto append = [&](char c) {
+        if (separator && !key.empty()) key += '-';
+        separator = false;
+        key += c;
+    };
+
+    for (size_t i = 0; i < name.size(); ++i) {
+        char c = name[i];
+        if (c >= 'A' && c <= 'Z') {
+            append(static_cast<char>(c - 'A' + 'a'));
+        } else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+            append(c);
+        } else if (c == ' ' || c == '_' || c == '-') {
+            separator = true;
+        } else if (name.compare(i, 3, "\u2640") == 0 || name.compare(i, 3, "\u2642") == 0) {
+            separator = true;
+            append(name.compare(i, 3, "\u2640") == 0 ? 'f' : 'm');
+            i += 2;
+        } else if (name.compare(i, 2, "\u00e9") == 0 || name.compare(i, 2, "\u00c9") == 0) {
+            append('e');
+            i += 1;
+        }
+        // Otra puntuación ('.', ':', '\'') se descarta sin separar
+    }
+    return key;
+}
+
+bool SpriteIndex::loadFromCsv(const string& filename) {
+    CsvReader csv;
+    if (!csv.open(filename)) {
+        cerr << "Error al abrir " << filename << endl;
+        return false;
+    }
+
+    vector<string_view> fields;
+    csv.nextRow(fields); // Skip header
+
+    while (csv.nextRow(fields)) {
+        if (fields.size() < 6) continue;
+        SpriteRegion region;
+        region.page = static_cast<uint16_t>(csvInt(fields[1]));
+        region.x = static_cast<uint16_t>(csvInt(fields[2]));
+        region.y = static_cast<uint16_t>(csvInt(fields[3]));
+        region.width = static_cast<uint16_t>(csvInt(fields[4]));
+        region.height = static_cast<uint16_t>(csvInt(fields[5]));
+        add(fields[0], region);
+    }
+    return true;
+}
+
+bool SpriteIndex::saveToCsv(const string& filename) const {
+    // Ordenado por clave, para que el archivo generado no cambie entre ejecuciones
+    vector<const pair<const string, SpriteRegion>*> sorted;
+    for (const auto& entry : regions) sorted.push_back(&entry);
+    sort(sorted.begin(), sorted.end(), [](auto a, auto b) { return a->first < b->first; });
+
+    ofstream out(filename);
+    out << "key,page,x,y,width,height\n";
+    for (const auto* entry : sorted) {
+        const SpriteRegion& r = entry->second;
+        out << entry->first << ',' << r.page << ',' << r.x << ',' << r.y << ','
+            << r.width << ',' << r.height << '\n';
+    }
+    return (bool)out;
+}
+
+void SpriteIndex::add(string_view name, SpriteRegion region) {
+    regions[spriteKey(name)] = region;
+    pages = max(pages, size_t(region.page) + 1);
+}
+
+const SpriteRegion* SpriteIndex::find(string_view name) const {
+    auto it = regions.find(spriteKey(name));
+    return it != regions.end() ? &it->second : nullptr;
+}
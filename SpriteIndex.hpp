@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Índice del atlas de miniaturas que genera build_sprites: por cada imagen de
+// Pokemon_Dataset, en qué página del atlas está y en qué rectángulo. Se guarda
+// como CSV (clave,página,x,y,ancho,alto) junto a las páginas PNG.
+
+// Lados de las variantes que genera build_sprites para cada imagen, de menor a
+// mayor: resultados (y el atlas), dropdowns de la derecha y defensor.
+constexpr unsigned kSpriteLevels[] = {64, 150, 400};
+constexpr size_t kSpriteLevelCount = sizeof(kSpriteLevels) / sizeof(kSpriteLevels[0]);
+
+// La variante más chica que cubre displaySize; la mayor si ninguna alcanza
+unsigned spriteLevelFor(float displaySize);
+
+// Clave normalizada de un nombre de imagen, para que coincidan los nombres de
+// pokemon_data.csv y los de los archivos: minúsculas, palabras separadas por
+// un solo '-' y sin puntuación; ♀/♂ como -f/-m y é como e.
+// "Abomasnow Mega Abomasnow" -> "abomasnow-mega-abomasnow", "Mr. Mime" -> "mr-mime"
+std::string spriteKey(std::string_view name);
+
+struct SpriteRegion {
+    uint16_t page;
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+};
+
+class SpriteIndex {
+public:
+    bool loadFromCsv(const std::string& filename);
+    bool saveToCsv(const std::string& filename) const;
+
+    void add(std::string_view name, SpriteRegion region);
+
+    // nullptr si el atlas no tiene esa imagen; acepta nombres sin normalizar
+    const SpriteRegion* find(std::string_view name) const;
+
+    size_t size() const { return regions.size(); }
+    size_t pageCount() const { return pages; }
+
+private:
+    std::unordered_map<std::string, SpriteRegion> regions;
+    size_t pages = 0;
+};
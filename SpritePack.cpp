@@ -0,0 +1,82 @@
+#include "SpritePack.hpp"
+
+#include <iostream>
+
+using namespace std;
+
+bool SpritePack::sectionFits(DatasetSection s, size_t elementSize, size_t alignment) const {
+    return s.offset % alignment == 0 && s.offset <= file.size() && s.count <= (file.size() - s.offset) / elementSize;
+}
+
+bool SpritePack::open(const string& filename) {
+    header = nullptr;
+    if (!file.open(filename)) return false;
+
+    if (file.size() < sizeof(SpritePackHeader)) {
+        cerr << filename << ": archivo demasiado corto" << endl;
+        return false;
+    }
+
+    const SpritePackHeader* h = reinterpret_cast<const SpritePackHeader*>(file.data());
+    if (h->magic != kSpritePackMagic || h->version != kSpritePackVersion || h->fileSize != file.size()) {
+        cerr << filename << ": formato o versión no soportados, regenerar con build_sprites" << endl;
+        return false;
+    }
+
+    if (!sectionFits(h->images, sizeof(SpritePackImage), alignof(SpritePackImage)) ||
+        !sectionFits(h->names, sizeof(SpritePackName), alignof(SpritePackName)) ||
+        !sectionFits(h->strings, 1, 1)) {
+        cerr << filename << ": secciones fuera de rango o desalineadas" << endl;
+        return false;
+    }
+
+    // Los blobs se validan una vez aquí para no comprobarlos en cada decodificación
+    const SpritePackImage* images = reinterpret_cast<const SpritePackImage*>(file.data() + h->images.offset);
+    for (size_t i = 0; i < h->images.count; ++i) {
+        for (const SpritePackBlob& blob : images[i].variants) {
+            if (blob.offset > file.size() || blob.size > file.size() - blob.offset) {
+                cerr << filename << ": imagen fuera de rango" << endl;
+                return false;
+            }
+        }
+    }
+
+    // Igual con los nombres, para que find() no lea fuera de la sección de textos
+    const SpritePackName* names = reinterpret_cast<const SpritePackName*>(file.data() + h->names.offset);
+    for (size_t i = 0; i < h->names.count; ++i) {
+        const DatasetString& name = names[i].name;
+        if (name.offset > h->strings.count || name.length > h->strings.count - name.offset ||
+            names[i].image >= h->images.count) {
+            cerr << filename << ": nombre fuera de rango" << endl;
+            return false;
+        }
+    }
+
+    header = h;
+    return true;
+}
+
+int SpritePack::find(string_view name) const {
+    string key = spriteKey(name);
+    const SpritePackName* names = section<SpritePackName>(header->names);
+    size_t lo = 0, hi = header->names.count;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (str(names[mid].name) < key) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo < header->names.count && str(names[lo].name) == key) {
+        return static_cast<int>(names[lo].image);
+    }
+    return -1;
+}
+
+string_view SpritePack::variant(int image, unsigned level) const {
+    const SpritePackImage& record = section<SpritePackImage>(header->images)[image];
+    for (size_t l = 0; l < kSpriteLevelCount; ++l) {
+        if (kSpriteLevels[l] != level) continue;
+        const SpritePackBlob& blob = record.variants[l];
+        return string_view(reinterpret_cast<const char*>(file.data()) + blob.offset, blob.size);
+    }
+    return string_view();
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "Dataset.hpp"
+#include "SpriteIndex.hpp"
+
+// Paquete con las imágenes de Pokemon_Dataset (sprites.pak), generado por
+// build_sprites. Guarda los PNG de cada variante de kSpriteLevels uno tras
+// otro y un índice de nombres ordenado, con las claves de los archivos y los
+// alias de los nombres de pokemon_data.csv que no coinciden con ningún archivo.
+// Se mapea en memoria una vez y las imágenes se decodifican desde ahí.
+
+constexpr uint32_t kSpritePackMagic = 0x4B505350;   // "PSPK"
+constexpr uint32_t kSpritePackVersion = 1;
+
+struct SpritePackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t fileSize;
+    uint32_t reserved;
+    DatasetSection images;    // SpritePackImage
+    DatasetSection names;     // SpritePackName, ordenados por nombre
+    DatasetSection strings;   // char
+};
+
+// Bytes de un PNG dentro del archivo
+struct SpritePackBlob {
+    uint32_t offset;
+    uint32_t size;
+};
+
+struct SpritePackImage {
+    SpritePackBlob variants[kSpriteLevelCount];   // En el orden de kSpriteLevels
+};
+
+// Clave normalizada (spriteKey) -> imagen; varias claves pueden ir a la misma
+struct SpritePackName {
+    DatasetString name;
+    uint32_t image;
+};
+
+static_assert(sizeof(SpritePackHeader) == 40, "SpritePackHeader debe tener ancho fijo");
+static_assert(sizeof(SpritePackName) == 12, "SpritePackName debe tener ancho fijo");
+
+// Vista de solo lectura sobre un sprites.pak mapeado; se puede consultar
+// desde varios hilos a la vez
+class SpritePack {
+public:
+    bool open(const std::string& filename);
+    bool isOpen() const { return header != nullptr; }
+
+    // Búsqueda binaria por clave; acepta nombres sin normalizar. -1 si no existe
+    int find(std::string_view name) const;
+
+    // PNG de la variante de lado level (uno de kSpriteLevels); vacío si no existe
+    std::string_view variant(int image, unsigned level) const;
+
+    size_t imageCount() const { return header->images.count; }
+    size_t nameCount() const { return header->names.count; }
+
+private:
+    template <typename T>
+    const T* section(DatasetSection s) const {
+        return reinterpret_cast<const T*>(file.data() + s.offset);
+    }
+
+    std::string_view str(DatasetString s) const {
+        return std::string_view(section<char>(header->strings) + s.offset, s.length);
+    }
+
+    bool sectionFits(DatasetSection s, size_t elementSize, size_t alignment) const;
+
+    MappedFile file;
+    const SpritePackHeader* header = nullptr;
+};
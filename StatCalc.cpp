@@ -0,0 +1,85 @@
+#include "StatCalc.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+using namespace std;
+
+// Orden clásico de la tabla: fila = estadística que sube, columna = la que baja
+static const char* const natureNames[5][5] = {
+    {"Hardy", "Lonely", "Adamant", "Naughty", "Brave"},
+    {"Bold", "Docile", "Impish", "Lax", "Relaxed"},
+    {"Modest", "Mild", "Bashful", "Rash", "Quiet"},
+    {"Calm", "Gentle", "Careful", "Quirky", "Sassy"},
+    {"Timid", "Hasty", "Jolly", "Naive", "Serious"},
+};
+static const Stat natureStats[5] = {Stat::Attack, Stat::Defense, Stat::SpAttack, Stat::SpDefense, Stat::Speed};
+
+Nature parseNature(string_view name) {
+    for (int up = 0; up < 5; ++up) {
+        for (int down = 0; down < 5; ++down) {
+            if (name == natureNames[up][down]) return {natureStats[up], natureStats[down]};
+        }
+    }
+    return {};
+}
+
+static bool sameSpread(const StatSpread& a, const StatSpread& b) {
+    return memcmp(a.iv, b.iv, sizeof(a.iv)) == 0 && memcmp(a.ev, b.ev, sizeof(a.ev)) == 0 &&
+           a.nature.raised == b.nature.raised && a.nature.lowered == b.nature.lowered;
+}
+
+SpreadId StatCalc::addSpread(const StatSpread& spread) {
+    unique_lock<shared_mutex> lock(cacheMutex);
+    for (size_t i = 0; i < spreads.size(); ++i) {
+        if (sameSpread(spreads[i], spread)) return static_cast<SpreadId>(i);
+    }
+    spreads.push_back(spread);
+    return static_cast<SpreadId>(spreads.size() - 1);
+}
+
+BattleStats StatCalc::compute(const int16_t base[kStatCount], int level, const StatSpread& spread) {
+    uint16_t out[kStatCount];
+    for (int s = 0; s < kStatCount; ++s) {
+        int ev = min<int>(spread.ev[s], 252);
+        int iv = min<int>(spread.iv[s], 31);
+        int core = (2 * base[s] + iv + ev / 4) * level / 100;
+
+        if (s == static_cast<int>(Stat::Hp)) {
+            // Shedinja (PS base 1) siempre tiene 1 PS
+            out[s] = static_cast<uint16_t>(base[s] == 1 ? 1 : core + level + 10);
+            continue;
+        }
+
+        int value = core + 5;
+        if (spread.nature.raised != spread.nature.lowered) {
+            if (static_cast<int>(spread.nature.raised) == s) value = value * 110 / 100;
+            else if (static_cast<int>(spread.nature.lowered) == s) value = value * 90 / 100;
+        }
+        out[s] = static_cast<uint16_t>(value);
+    }
+    return {out[0], out[1], out[2], out[3], out[4], out[5]};
+}
+
+BattleStats StatCalc::stats(SpeciesId id, int level, SpreadId spread) const {
+    uint64_t k = key(id, level, spread);
+    {
+        shared_lock<shared_mutex> lock(cacheMutex);
+        auto it = cache.find(k);
+        if (it != cache.end()) return it->second;
+    }
+
+    const SpeciesTable& s = *species;
+    int16_t base[kStatCount] = {s.hp[id], s.attack[id], s.defense[id], s.spAttack[id], s.spDefense[id], s.speed[id]};
+
+    unique_lock<shared_mutex> lock(cacheMutex);
+    BattleStats result = compute(base, level, spreads[spread < spreads.size() ? spread : kDefaultSpread]);
+    cache.emplace(k, result);
+    return result;
+}
+
+size_t StatCalc::cachedCount() const {
+    shared_lock<shared_mutex> lock(cacheMutex);
+    return cache.size();
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "SpeciesTable.hpp"
+
+enum class Stat : uint8_t { Hp, Attack, Defense, SpAttack, SpDefense, Speed };
+constexpr int kStatCount = 6;
+
+// Una de las 25 naturalezas: sube una estadística un 10% y baja otra un 10%.
+// Las neutras suben y bajan la misma (sin efecto)
+struct Nature {
+    Stat raised = Stat::Attack;
+    Stat lowered = Stat::Attack;
+};
+
+// "Adamant" -> +Atk -SpA; nombres desconocidos dan una naturaleza neutra
+Nature parseNature(std::string_view name);
+
+// IVs (0..31), EVs (0..252) y naturaleza de un Pokémon
+struct StatSpread {
+    uint8_t iv[kStatCount] = {31, 31, 31, 31, 31, 31};
+    uint8_t ev[kStatCount] = {0, 0, 0, 0, 0, 0};
+    Nature nature;
+};
+
+using SpreadId = uint16_t;
+
+// Estadísticas reales de combate
+struct BattleStats {
+    uint16_t hp;
+    uint16_t attack;
+    uint16_t defense;
+    uint16_t spAttack;
+    uint16_t spDefense;
+    uint16_t speed;
+};
+
+// Un Pokémon concreto: especie, nivel y estadísticas ya calculadas
+struct Combatant {
+    SpeciesId species;
+    int level;
+    BattleStats stats;
+};
+
+// Calcula estadísticas a partir de las base de pokemon.csv con las fórmulas
+// de la 3.ª generación en adelante, y las memoriza por (especie, nivel,
+// spread). Los spreads se registran una vez y se identifican por un SpreadId
+// de 16 bits, así la clave de la caché cabe en un entero de 64 bits.
+// Puede consultarse desde varios hilos a la vez.
+class StatCalc {
+public:
+    explicit StatCalc(const SpeciesTable& species) : species(&species) {}
+
+    // Registra el spread (o devuelve el ID que ya tenía). El 0 es el spread por
+    // defecto: IVs 31, sin EVs, naturaleza neutra
+    SpreadId addSpread(const StatSpread& spread);
+    static constexpr SpreadId kDefaultSpread = 0;
+
+    BattleStats stats(SpeciesId id, int level, SpreadId spread = kDefaultSpread) const;
+    Combatant combatant(SpeciesId id, int level, SpreadId spread = kDefaultSpread) const {
+        return {id, level, stats(id, level, spread)};
+    }
+
+    // Sin memorizar
+    static BattleStats compute(const int16_t base[kStatCount], int level, const StatSpread& spread);
+
+    size_t cachedCount() const;
+
+private:
+    static uint64_t key(SpeciesId id, int level, SpreadId spread) {
+        return (uint64_t(id) << 32) | (uint64_t(level & 0xFFFF) << 16) | spread;
+    }
+
+    const SpeciesTable* species;
+    mutable std::shared_mutex cacheMutex;
+    std::vector<StatSpread> spreads{StatSpread()};
+    mutable std::unordered_map<uint64_t, BattleStats> cache;
+};
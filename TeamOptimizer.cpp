@@ -0,0 +1,165 @@
+#include "TeamOptimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+
+#include "TopK.hpp"
+
+using namespace std;
+
+namespace {
+
+struct BetterMember {
+    TeamObjective objective;
+
+    bool operator()(const TeamMember& a, const TeamMember& b) const {
+        if (objective == TeamObjective::KoChance) {
+            if (a.ko.ohko != b.ko.ohko) return a.ko.ohko > b.ko.ohko;
+            if (a.ko.twoHko != b.ko.twoHko) return a.ko.twoHko > b.ko.twoHko;
+            if (a.ko.threeHko != b.ko.threeHko) return a.ko.threeHko > b.ko.threeHko;
+        }
+        return a.damage.maxDamage > b.damage.maxDamage;
+    }
+};
+
+// Datos del defensor que comparten todos los hilos
+struct SearchContext {
+    Combatant defender;
+    TeamObjective objective;
+    vector<uint64_t> damaging;      // Máscara de movimientos con categoría física o especial
+    vector<float> effectiveness;    // Por MoveId, contra los tipos del defensor
+};
+
+// Cota superior del daño máximo de la especie con cualquiera de sus movimientos legales:
+// floor(B*E*base) <= B*E*(c*A*P)/(25*D) + 2*B*E, maximizando cada producto por separado
+float damageBound(const DamageEngine& engine, const Learnsets& learnsets,
+                  const SearchContext& ctx, const Combatant& attacker) {
+    const SpeciesTable& s = engine.speciesTable();
+    SpeciesId a = attacker.species;
+    double bestProduct[2] = {0, 0}, bestMultiplier[2] = {0, 0};   // [física, especial]
+
+    learnsets.forEachMove(a, ctx.damaging.data(), [&](MoveId id) {
+        const MoveData& m = engine.move(id);
+        int c = m.category == MoveCategory::Physical ? 0 : 1;
+        bool stab = (m.type == s.type1[a] || m.type == s.type2[a]) && m.type != PokeType::None;
+        double multiplier = (stab ? 1.5 : 1.0) * ctx.effectiveness[id];
+        bestProduct[c] = max(bestProduct[c], multiplier * m.power);
+        bestMultiplier[c] = max(bestMultiplier[c], multiplier);
+    });
+
+    double levelTerm = 0.2 * attacker.level + 1;
+    int A[2] = {attacker.stats.attack, attacker.stats.spAttack};
+    int D[2] = {ctx.defender.stats.defense, ctx.defender.stats.spDefense};
+    double bound = 0;
+    for (int c = 0; c < 2; ++c) {
+        if (D[c] <= 0 || bestMultiplier[c] == 0) continue;
+        bound = max(bound, bestProduct[c] * levelTerm * A[c] / (25.0 * D[c]) + 2 * bestMultiplier[c]);
+    }
+    return static_cast<float>(bound) + 1.0f;   // Margen por el redondeo en float del motor
+}
+
+// Mejor caso posible para una especie con esa cota, comparable con BetterMember
+TeamMember boundMember(const SearchContext& ctx, float bound) {
+    TeamMember m = {};
+    m.damage = {bound, bound};
+    float critBound = bound * 1.5f;
+    int hp = ctx.defender.stats.hp;
+    m.ko.ohko = critBound >= hp ? 1.0 : 0.0;
+    m.ko.twoHko = critBound * 2 >= hp ? 1.0 : 0.0;
+    m.ko.threeHko = critBound * 3 >= hp ? 1.0 : 0.0;
+    return m;
+}
+
+TeamMember evaluate(const DamageEngine& engine, const Learnsets& learnsets,
+                    const SearchContext& ctx, const Combatant& attacker) {
+    BetterMember better{ctx.objective};
+    TopK<TeamMember, BetterMember> bestMoves(kMovesPerMember, better);
+
+    learnsets.forEachMove(attacker.species, ctx.damaging.data(), [&](MoveId id) {
+        TeamMember candidate = {};
+        candidate.species = attacker.species;
+        candidate.moves[0] = id;
+        candidate.damage = engine.compute(attacker, id, ctx.defender);
+        // Sin crítico que llegue en 3 golpes las probabilidades son 0 y no hace falta convolucionar
+        if (ctx.objective == TeamObjective::KoChance &&
+            candidate.damage.maxDamage * 1.5f * 3 >= ctx.defender.stats.hp) {
+            candidate.ko = engine.koChances(attacker, id, ctx.defender);
+        }
+        bestMoves.push(candidate, id);
+    });
+
+    vector<TeamMember> ranked = bestMoves.sorted();
+    TeamMember member = {};
+    member.species = attacker.species;
+    if (ranked.empty()) return member;
+
+    member.damage = ranked[0].damage;
+    member.ko = ranked[0].ko;
+    member.moveCount = static_cast<uint8_t>(ranked.size());
+    for (size_t i = 0; i < ranked.size(); ++i) member.moves[i] = ranked[i].moves[0];
+    return member;
+}
+
+}
+
+vector<TeamMember> TeamOptimizer::optimize(SpeciesId defender, int defenderLevel, int attackerLevel,
+                                           TeamObjective objective, size_t teamSize,
+                                           const function<bool()>& cancelled) const {
+    const SpeciesTable& s = engine->speciesTable();
+    const TypeChart& chart = engine->typeChart();
+
+    SearchContext ctx;
+    ctx.defender = statCalc->combatant(defender, defenderLevel);
+    ctx.objective = objective;
+    ctx.damaging = Learnsets::moveMask(engine->moveTable(), [](const MoveData& m) {
+        return m.category != MoveCategory::Status && m.power > 0;
+    });
+    ctx.effectiveness.resize(engine->moveCount());
+    for (size_t m = 0; m < engine->moveCount(); ++m) {
+        ctx.effectiveness[m] = chart.effectiveness(engine->move(static_cast<MoveId>(m)).type,
+                                                   s.type1[defender], s.type2[defender]);
+    }
+
+    // Especies candidatas con learnset, de mayor a menor cota
+    vector<pair<float, Combatant>> order;
+    for (size_t a = 0; a < s.size(); ++a) {
+        SpeciesId id = static_cast<SpeciesId>(a);
+        if (!learnsets->hasData(id)) continue;
+        if (!candidates.empty() && (a >= candidates.size() || !candidates[a])) continue;
+        Combatant attacker = statCalc->combatant(id, attackerLevel);
+        float bound = damageBound(*engine, *learnsets, ctx, attacker);
+        if (bound > 1.0f) order.emplace_back(bound, attacker);
+    }
+    stable_sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    // Reparto intercalado: cada hilo recibe especies de todas las alturas de la cota,
+    // y dentro de su parte puede cortar en cuanto una cota ya no alcanza
+    BetterMember better{objective};
+    size_t threads = max<size_t>(1, pool->size());
+    vector<future<pair<TopK<TeamMember, BetterMember>, size_t>>> parts;
+    for (size_t t = 0; t < threads; ++t) {
+        parts.push_back(pool->submit([&, t]() {
+            TopK<TeamMember, BetterMember> local(teamSize, better);
+            size_t count = 0;
+            for (size_t i = t; i < order.size(); i += threads) {
+                if (cancelled && cancelled()) break;
+                if (local.full() && !better(boundMember(ctx, order[i].first), local.worst())) break;
+                local.push(evaluate(*engine, *learnsets, ctx, order[i].second), order[i].second.species);
+                ++count;
+            }
+            return make_pair(move(local), count);
+        }));
+    }
+
+    TopK<TeamMember, BetterMember> team(teamSize, better);
+    size_t count = 0;
+    for (auto& part : parts) {
+        auto result = part.get();
+        team.merge(result.first);
+        count += result.second;
+    }
+    evaluated = count;
+    if (cancelled && cancelled()) return {};
+    return team.sorted();
+}
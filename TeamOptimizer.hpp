@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "DamageEngine.hpp"
+#include "Learnsets.hpp"
+#include "StatCalc.hpp"
+#include "ThreadPool.hpp"
+
+constexpr size_t kTeamSize = 6;
+constexpr size_t kMovesPerMember = 4;
+
+enum class TeamObjective { Damage, KoChance };
+
+struct TeamMember {
+    SpeciesId species;
+    MoveId moves[kMovesPerMember];   // Del mejor al peor contra el defensor
+    uint8_t moveCount;
+    DamageRange damage;              // Del mejor movimiento (moves[0])
+    KoChances ko;
+};
+
+// Busca en toda la tabla de especies el equipo que más daño hace (o más
+// probabilidad de KO tiene) contra un defensor, con los movimientos legales
+// de cada especie. Contra un único defensor un conjunto de 4 movimientos vale
+// lo que su mejor movimiento, así que cada especie se queda con sus 4 mejores
+// y el equipo con las mejores especies.
+//
+// Cada especie tiene una cota superior barata (mejor STAB * efectividad *
+// potencia por categoría, con su mejor relación ataque/defensa); las especies
+// se recorren por cota descendente y se dejan de evaluar en cuanto la cota no
+// supera al peor miembro del equipo. El trabajo se reparte entre los hilos del
+// pool y cada hilo mantiene su propio TopK. La misma búsqueda, por daño y con
+// N resultados, sirve para encontrar los mejores atacantes contra un defensor.
+// Cota y evaluación usan las estadísticas reales (StatCalc) al nivel pedido.
+class TeamOptimizer {
+public:
+    TeamOptimizer(const DamageEngine& engine, const Learnsets& learnsets, const StatCalc& statCalc, ThreadPool& pool)
+        : engine(&engine), learnsets(&learnsets), statCalc(&statCalc), pool(&pool) {}
+
+    // Del mejor al peor miembro; el defensor a defenderLevel y los atacantes a attackerLevel.
+    // Se consulta cancelled antes de cada especie; si devuelve true la búsqueda se
+    // abandona y el resultado queda vacío
+    std::vector<TeamMember> optimize(SpeciesId defender, int defenderLevel, int attackerLevel,
+                                     TeamObjective objective, size_t teamSize = kTeamSize,
+                                     const std::function<bool()>& cancelled = nullptr) const;
+
+    // Las n especies con el mejor ataque legal contra el defensor, por daño máximo
+    std::vector<TeamMember> counters(SpeciesId defender, int defenderLevel, int attackerLevel, size_t n,
+                                     const std::function<bool()>& cancelled = nullptr) const {
+        return optimize(defender, defenderLevel, attackerLevel, TeamObjective::Damage, n, cancelled);
+    }
+
+    // Limita la búsqueda a las especies marcadas (indexado por SpeciesId); vacío = todas
+    void setCandidates(std::vector<bool> allowed) { candidates = std::move(allowed); }
+
+    // Especies evaluadas por completo en la última búsqueda (el resto se podó)
+    size_t lastEvaluated() const { return evaluated.load(); }
+
+private:
+    const DamageEngine* engine;
+    const Learnsets* learnsets;
+    const StatCalc* statCalc;
+    ThreadPool* pool;
+    std::vector<bool> candidates;
+    mutable std::atomic<size_t> evaluated{0};
+};
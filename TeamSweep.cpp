@@ -0,0 +1,90 @@
+#include "TeamSweep.hpp"
+
+#include <algorithm>
+#include <future>
+
+using namespace std;
+
+namespace {
+
+struct AttackPair {
+    Combatant attacker;
+    MoveId move;
+};
+
+}
+
+vector<DefenderThreat> TeamSweep::threats(const vector<TeamSlot>& team, int defenderLevel,
+                                          float thresholdPercent, const function<bool()>& cancelled) const {
+    const SpeciesTable& s = engine->speciesTable();
+    size_t count = s.size();
+
+    vector<AttackPair> pairs;
+    for (const TeamSlot& slot : team) {
+        Combatant attacker = statCalc->combatant(slot.attacker, slot.level);
+        for (MoveId move : slot.moves) {
+            if (engine->move(move).category == MoveCategory::Status) continue;
+            pairs.push_back({attacker, move});
+        }
+    }
+
+    // Columnas con las defensas reales de cada defensor para el kernel, y sus PS
+    // como float para pasar el daño de cada barrido a porcentaje
+    vector<int16_t> defense(count), spDefense(count);
+    vector<float> hpScale(count);
+    for (size_t d = 0; d < count; ++d) {
+        BattleStats stats = statCalc->stats(static_cast<SpeciesId>(d), defenderLevel);
+        defense[d] = static_cast<int16_t>(stats.defense);
+        spDefense[d] = static_cast<int16_t>(stats.spDefense);
+        hpScale[d] = stats.hp > 0 ? 100.0f / stats.hp : 0.0f;
+    }
+
+    // Cada hilo recorre pares distintos y guarda su mejor golpe por defensor
+    size_t threads = min(max<size_t>(1, pool->size()), max<size_t>(1, pairs.size()));
+    vector<future<vector<DefenderThreat>>> parts;
+    for (size_t t = 0; t < threads; ++t) {
+        parts.push_back(pool->submit([&, t]() {
+            vector<DefenderThreat> best(count);
+            for (size_t d = 0; d < count; ++d) best[d] = {static_cast<SpeciesId>(d), 0.0f, 0, 0};
+
+            vector<float> minOut(count), maxOut(count);
+            for (size_t p = t; p < pairs.size(); p += threads) {
+                if (cancelled && cancelled()) break;
+                const AttackPair& pair = pairs[p];
+                engine->sweepDefenders(pair.attacker, pair.move, defense.data(), spDefense.data(),
+                                       minOut.data(), maxOut.data());
+                for (size_t d = 0; d < count; ++d) {
+                    float percent = maxOut[d] * hpScale[d];
+                    if (percent > best[d].bestPercent) {
+                        best[d] = {best[d].defender, percent, pair.attacker.species, pair.move};
+                    }
+                }
+            }
+            return best;
+        }));
+    }
+
+    vector<DefenderThreat> best;
+    for (auto& part : parts) {
+        vector<DefenderThreat> local = part.get();
+        if (best.empty()) {
+            best = move(local);
+            continue;
+        }
+        for (size_t d = 0; d < count; ++d) {
+            if (local[d].bestPercent > best[d].bestPercent) best[d] = local[d];
+        }
+    }
+
+    if (cancelled && cancelled()) return {};
+
+    vector<DefenderThreat> result;
+    for (const DefenderThreat& threat : best) {
+        if (!candidates.empty() && (threat.defender >= candidates.size() || !candidates[threat.defender])) continue;
+        if (threat.bestPercent < thresholdPercent) result.push_back(threat);
+    }
+    stable_sort(result.begin(), result.end(), [](const DefenderThreat& a, const DefenderThreat& b) {
+        return a.bestPercent < b.bestPercent;
+    });
+    return result;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "DamageEngine.hpp"
+#include "StatCalc.hpp"
+#include "ThreadPool.hpp"
+
+// Un atacante del equipo con sus movimientos elegidos
+struct TeamSlot {
+    SpeciesId attacker;
+    int level;
+    std::vector<MoveId> moves;
+};
+
+// Mejor golpe del equipo contra un defensor, en % de sus PS reales
+struct DefenderThreat {
+    SpeciesId defender;
+    float bestPercent;     // 0 si nadie del equipo le hace daño
+    SpeciesId attacker;
+    MoveId move;
+};
+
+// Evalúa un equipo contra todos los defensores de la tabla. Cada par
+// (atacante, movimiento) es un barrido del kernel vectorizado sobre los
+// defensores contiguos (DamageEngine::sweepDefenders); los pares se reparten
+// entre los hilos del pool y cada hilo acumula su mejor golpe por defensor.
+// Atacantes y defensores usan sus estadísticas reales (StatCalc) a su nivel.
+class TeamSweep {
+public:
+    TeamSweep(const DamageEngine& engine, const StatCalc& statCalc, ThreadPool& pool)
+        : engine(&engine), statCalc(&statCalc), pool(&pool) {}
+
+    // Defensores de nivel defenderLevel a los que ningún movimiento del equipo llega
+    // a quitar thresholdPercent de sus PS, del menos dañado al más dañado. Se
+    // consulta cancelled antes de cada par; si devuelve true el resultado queda vacío
+    std::vector<DefenderThreat> threats(const std::vector<TeamSlot>& team, int defenderLevel,
+                                        float thresholdPercent,
+                                        const std::function<bool()>& cancelled = nullptr) const;
+
+    // Limita los defensores a las especies marcadas (indexado por SpeciesId); vacío = todas
+    void setCandidates(std::vector<bool> allowed) { candidates = std::move(allowed); }
+
+private:
+    const DamageEngine* engine;
+    const StatCalc* statCalc;
+    ThreadPool* pool;
+    std::vector<bool> candidates;
+};
@@ -0,0 +1,81 @@
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+// Pool y cola del hilo actual, para que las subtareas vayan a la cola propia
+static thread_local const ThreadPool* currentPool = nullptr;
+static thread_local size_t currentIndex = 0;
+
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+    for (unsigned i = 0; i < threads; ++i) {
+        queues.push_back(make_unique<WorkerQueue>());
+    }
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (thread& t : workers) t.join();
+}
+
+void ThreadPool::push(function<void()> task) {
+    size_t target = currentPool == this ? currentIndex : nextQueue++ % queues.size();
+    {
+        lock_guard<mutex> lock(queues[target]->mutex);
+        queues[target]->tasks.push_back(move(task));
+    }
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        ++pending;
+    }
+    wakeUp.notify_one();
+}
+
+bool ThreadPool::tryPop(size_t self, function<void()>& task) {
+    {
+        WorkerQueue& own = *queues[self];
+        lock_guard<mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = move(own.tasks.back());
+            own.tasks.pop_back();
+            --pending;
+            return true;
+        }
+    }
+    for (size_t i = 1; i < queues.size(); ++i) {
+        WorkerQueue& victim = *queues[(self + i) % queues.size()];
+        lock_guard<mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --pending;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentIndex = index;
+    while (true) {
+        function<void()> task;
+        if (tryPop(index, task)) {
+            task();
+            continue;
+        }
+
+        // pending puede quedar un instante por debajo de 0 si se roba una tarea
+        // antes de que push la cuente; el hilo solo vuelve a intentarlo
+        unique_lock<mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this]() { return stopping || pending > 0; });
+        if (stopping && pending <= 0) return;
+    }
+}
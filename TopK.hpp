@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Guarda los K mejores elementos vistos en un heap acotado: cada inserción es
+// O(log K) y nunca se ordena la colección completa. Better(a, b) indica si a
+// es estrictamente mejor que b; los empates se resuelven por orden de llegada,
+// así el resultado es estable. Pensado para que cada hilo tenga su propio TopK
+// y se combinen al final con merge().
+template <typename T, typename Better>
+class TopK {
+public:
+    explicit TopK(size_t k, Better better = Better()) : k(k), better(better) {
+        heap.reserve(k);
+    }
+
+    // order es la posición global del elemento; con varios hilos debe ser única
+    // para que los empates salgan en el mismo orden que en una pasada secuencial
+    void push(const T& item, uint64_t order) {
+        if (k == 0) return;
+        Entry entry{item, order};
+        if (heap.size() < k) {
+            heap.push_back(std::move(entry));
+            std::push_heap(heap.begin(), heap.end(), comparator());
+        } else if (isBetter(entry, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), comparator());
+            heap.back() = std::move(entry);
+            std::push_heap(heap.begin(), heap.end(), comparator());
+        }
+    }
+
+    void push(const T& item) { push(item, next++); }
+
+    void merge(const TopK& other) {
+        for (const Entry& entry : other.heap) push(entry.item, entry.order);
+    }
+
+    // Peor elemento guardado; sirve de cota para podar cuando el heap está lleno
+    bool full() const { return heap.size() == k; }
+    const T& worst() const { return heap.front().item; }
+
+    size_t size() const { return heap.size(); }
+
+    // Los elementos guardados, del mejor al peor
+    std::vector<T> sorted() const {
+        std::vector<Entry> entries = heap;
+        std::sort_heap(entries.begin(), entries.end(), comparator());
+        std::vector<T> items;
+        items.reserve(entries.size());
+        for (Entry& entry : entries) items.push_back(std::move(entry.item));
+        return items;
+    }
+
+private:
+    struct Entry {
+        T item;
+        uint64_t order;
+    };
+
+    bool isBetter(const Entry& a, const Entry& b) const {
+        if (better(a.item, b.item)) return true;
+        if (better(b.item, a.item)) return false;
+        return a.order < b.order;
+    }
+
+    // Con esta comparación la cima del heap es el peor elemento guardado
+    auto comparator() const {
+        return [this](const Entry& a, const Entry& b) { return isBetter(a, b); };
+    }
+
+    size_t k;
+    Better better;
+    uint64_t next = 0;
+    std::vector<Entry> heap;
+};
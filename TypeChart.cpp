@@ -0,0 +1,103 @@
+#include "TypeChart.hpp"
+#include "Dataset.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "CsvReader.hpp"
+
+using namespace std;
+
+static const char* const typeNames[kTypeSlots] = {
+    "Normal", "Fire", "Water", "Electric", "Grass", "Ice", "Fighting", "Poison", "Ground",
+    "Flying", "Psychic", "Bug", "Rock", "Ghost", "Dragon", "Dark", "Steel", "Fairy",
+    ""
+};
+
+PokeType parseType(string_view name) {
+    for (int i = 0; i < kNumTypes; ++i) {
+        if (name == typeNames[i]) return static_cast<PokeType>(i);
+    }
+    return PokeType::None;
+}
+
+const char* typeName(PokeType type) {
+    return typeNames[static_cast<int>(type)];
+}
+
+TypeChart::TypeChart() {
+    for (auto& r : singleTable)
+        for (float& e : r) e = 1.0f;
+    for (auto& r : dualTable)
+        for (float& e : r) e = 1.0f;
+}
+
+bool TypeChart::loadFromCsv(const string& filename) {
+    CsvReader csv;
+    if (!csv.open(filename)) {
+        cerr << "Error al abrir " << filename << endl;
+        return false;
+    }
+
+    vector<string_view> fields;
+    vector<PokeType> attackTypes;
+    if (!csv.nextRow(fields)) return false;
+    for (size_t i = 2; i < fields.size(); i++) {
+        attackTypes.push_back(parseType(fields[i]));
+    }
+
+    bool loaded[kTypeSlots * kTypeSlots] = {};
+
+    while (csv.nextRow(fields)) {
+        if (fields.size() < 2) continue;
+        PokeType d1 = parseType(fields[0]);
+        PokeType d2 = parseType(fields[1]);
+        if (d1 == PokeType::None) continue;
+
+        int r = rowIndex(d1, d2);
+        for (size_t i = 0; i < attackTypes.size() && i + 2 < fields.size(); i++) {
+            if (attackTypes[i] == PokeType::None) continue;
+            float e = csvFloat(fields[i + 2]);
+            dualTable[r][idx(attackTypes[i])] = e;
+            if (d2 == PokeType::None) singleTable[idx(d1)][idx(attackTypes[i])] = e;
+        }
+        loaded[r] = true;
+    }
+
+    resolveMissingRows(loaded);
+    return true;
+}
+
+// Completa las combinaciones que no vienen en el CSV: (t, t) y (t, None) equivalen
+// al tipo simple, (b, a) se copia de (a, b) y el resto se obtiene multiplicando.
+void TypeChart::resolveMissingRows(const bool (&loaded)[kTypeSlots * kTypeSlots]) {
+    for (int d1 = 0; d1 < kNumTypes; ++d1) {
+        for (int d2 = 0; d2 < kTypeSlots; ++d2) {
+            int r = d1 * kTypeSlots + d2;
+            if (loaded[r]) continue;
+
+            int mirrored = d2 * kTypeSlots + d1;
+            for (int a = 0; a < kNumTypes; ++a) {
+                if (d2 == d1 || d2 == kNumTypes) {
+                    dualTable[r][a] = singleTable[d1][a];
+                } else if (loaded[mirrored]) {
+                    dualTable[r][a] = dualTable[mirrored][a];
+                } else {
+                    dualTable[r][a] = singleTable[d1][a] * singleTable[d2][a];
+                }
+            }
+        }
+    }
+}
+
+// Las filas del archivo ya vienen resueltas; basta con copiarlas
+bool TypeChart::loadFromDataset(const Dataset& dataset) {
+    if (dataset.typeChartRowCount() != kTypeSlots * kTypeSlots) return false;
+
+    memcpy(dualTable, dataset.typeChartRows(), sizeof(dualTable));
+    for (int d = 0; d < kNumTypes; ++d) {
+        memcpy(singleTable[d], dualTable[d * kTypeSlots + kNumTypes], sizeof(singleTable[d]));
+    }
+    return true;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class Dataset;
+
+// Tipos en el mismo orden que las columnas de type-chart.csv
+enum class PokeType : uint8_t {
+    Normal, Fire, Water, Electric, Grass, Ice, Fighting, Poison, Ground,
+    Flying, Psychic, Bug, Rock, Ghost, Dragon, Dark, Steel, Fairy,
+    None
+};
+
+constexpr int kNumTypes = 18;
+// Una ranura extra para PokeType::None, siempre neutra (x1.0)
+constexpr int kTypeSlots = kNumTypes + 1;
+
+PokeType parseType(std::string_view name);
+const char* typeName(PokeType type);
+
+// Tabla de efectividad densa, construida una sola vez al arrancar.
+// Una consulta son dos indexaciones de arreglo, sin ramas ni strings.
+class TypeChart {
+public:
+    TypeChart();
+
+    bool loadFromCsv(const std::string& filename);
+    bool loadFromDataset(const Dataset& dataset);
+
+    // Multiplicador de un tipo de ataque contra un solo tipo defensor
+    float single(PokeType attack, PokeType defense) const {
+        return singleTable[idx(defense)][idx(attack)];
+    }
+
+    // Multiplicador contra un defensor de uno o dos tipos (defense2 = None si es de un tipo)
+    float effectiveness(PokeType attack, PokeType defense1, PokeType defense2 = PokeType::None) const {
+        return dualTable[rowIndex(defense1, defense2)][idx(attack)];
+    }
+
+    // Fila resuelta con los multiplicadores de cada tipo de ataque contra (defense1, defense2)
+    const float* row(PokeType defense1, PokeType defense2 = PokeType::None) const {
+        return dualTable[rowIndex(defense1, defense2)];
+    }
+
+    static int rowIndex(PokeType defense1, PokeType defense2) {
+        return idx(defense1) * kTypeSlots + idx(defense2);
+    }
+
+private:
+    static int idx(PokeType type) { return static_cast<int>(type); }
+
+    void resolveMissingRows(const bool (&loaded)[kTypeSlots * kTypeSlots]);
+
+    float singleTable[kTypeSlots][kTypeSlots];              // [defensa][ataque]
+    float dualTable[kTypeSlots * kTypeSlots][kTypeSlots];   // [defensa1 * 19 + defensa2][ataque]
+};
@@ -0,0 +1,316 @@
+// Genera a partir de Pokemon_Dataset los recursos de imagen que usa la
+// aplicación: sprites.pak, con cada imagen reducida a los lados de
+// kSpriteLevels (cada variante sale de la anterior, como una cadena de
+// mipmaps), y un atlas con las miniaturas de todas las especies (unas pocas
+// páginas PNG más un índice nombre -> rectángulo). Los nombres de
+// pokemon_data.csv sin archivo propio se agregan a ambos índices como alias.
+//
+// Uso: build_sprites [origen] [destino] [pokedex]
+// (por defecto Pokemon_Dataset sprites pokemon_data.csv)
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CsvReader.hpp"
+#include "SpriteIndex.hpp"
+#include "SpritePack.hpp"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// Lado de cada miniatura del atlas: la variante más chica
+const unsigned kThumbnailSize = kSpriteLevels[0];
+// Borde transparente entre celdas, para que el filtrado bilineal no mezcle vecinas
+const unsigned kCellPadding = 1;
+// Lado de cada página; 1024 lo soporta cualquier GPU
+const unsigned kPageSize = 1024;
+
+// Reduce la imagen para que su lado mayor mida maxSide, promediando cada bloque
+// de píxeles de origen. Se promedia con alfa premultiplicado para que el fondo
+// transparente no oscurezca los bordes.
+static sf::Image downscale(const sf::Image& source, unsigned maxSide) {
+    sf::Vector2u size = source.getSize();
+    unsigned longest = max(size.x, size.y);
+    if (longest <= maxSide) return source;
+
+    unsigned width = max(1u, size.x * maxSide / longest);
+    unsigned height = max(1u, size.y * maxSide / longest);
+    sf::Image result;
+    result.create(width, height, sf::Color::Transparent);
+
+    for (unsigned y = 0; y < height; ++y) {
+        unsigned y0 = y * size.y / height, y1 = max(y0 + 1, (y + 1) * size.y / height);
+        for (unsigned x = 0; x < width; ++x) {
+            unsigned x0 = x * size.x / width, x1 = max(x0 + 1, (x + 1) * size.x / width);
+
+            double r = 0, g = 0, b = 0, a = 0;
+            for (unsigned sy = y0; sy < y1; ++sy) {
+                for (unsigned sx = x0; sx < x1; ++sx) {
+                    sf::Color c = source.getPixel(sx, sy);
+                    r += c.r * c.a;
+                    g += c.g * c.a;
+                    b += c.b * c.a;
+                    a += c.a;
+                }
+            }
+            if (a == 0) continue;
+            double count = double(x1 - x0) * (y1 - y0);
+            result.setPixel(x, y, sf::Color(sf::Uint8(r / a + 0.5), sf::Uint8(g / a + 0.5),
+                                            sf::Uint8(b / a + 0.5), sf::Uint8(a / count + 0.5)));
+        }
+    }
+    return result;
+}
+
+// Reparte las miniaturas en una cuadrícula de celdas iguales por página
+class AtlasBuilder {
+public:
+    AtlasBuilder() : cell(kThumbnailSize + 2 * kCellPadding), perRow(kPageSize / cell) {}
+
+    void add(const string& name, const sf::Image& thumbnail) {
+        size_t slot = count % (perRow * perRow);
+        if (slot == 0) {
+            pages.emplace_back();
+            pages.back().create(kPageSize, kPageSize, sf::Color::Transparent);
+        }
+
+        SpriteRegion region;
+        region.page = static_cast<uint16_t>(pages.size() - 1);
+        region.x = static_cast<uint16_t>((slot % perRow) * cell + kCellPadding);
+        region.y = static_cast<uint16_t>((slot / perRow) * cell + kCellPadding);
+        region.width = static_cast<uint16_t>(thumbnail.getSize().x);
+        region.height = static_cast<uint16_t>(thumbnail.getSize().y);
+        pages.back().copy(thumbnail, region.x, region.y);
+        index.add(name, region);
+        ++count;
+    }
+
+    void addAlias(const string& alias, const string& key) {
+        const SpriteRegion* region = index.find(key);
+        if (region) index.add(alias, *region);
+    }
+
+    bool write(const fs::path& directory) const {
+        for (size_t p = 0; p < pages.size(); ++p) {
+            string path = (directory / ("atlas_" + to_string(p) + ".png")).string();
+            if (!pages[p].saveToFile(path)) {
+                cerr << "Error al escribir " << path << endl;
+                return false;
+            }
+        }
+        string indexPath = (directory / "atlas.csv").string();
+        if (!index.saveToCsv(indexPath)) {
+            cerr << "Error al escribir " << indexPath << endl;
+            return false;
+        }
+        return true;
+    }
+
+    size_t pageCount() const { return pages.size(); }
+
+private:
+    unsigned cell;
+    unsigned perRow;
+    size_t count = 0;
+    vector<sf::Image> pages;
+    SpriteIndex index;
+};
+
+// Escribe sprites.pak: los PNG se vuelcan según se generan y los índices van
+// al final; la cabecera se completa al cerrar
+class SpritePackWriter {
+public:
+    bool open(const string& filename) {
+        out.open(filename, ios::binary);
+        SpritePackHeader header = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        offset = sizeof(header);
+        return (bool)out;
+    }
+
+    SpritePackBlob addBlob(const vector<sf::Uint8>& bytes) {
+        SpritePackBlob blob{offset, (uint32_t)bytes.size()};
+        out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        offset += (uint32_t)bytes.size();
+        return blob;
+    }
+
+    void addImage(const string& key, const SpritePackImage& image) {
+        imageOf[key] = (uint32_t)images.size();
+        images.push_back(image);
+    }
+
+    void addAlias(const string& alias, const string& key) {
+        auto it = imageOf.find(key);
+        if (it != imageOf.end()) aliases.push_back({spriteKey(alias), it->second});
+    }
+
+    bool finish() {
+        // Claves y alias juntos, ordenados para la búsqueda binaria de SpritePack::find
+        vector<pair<string, uint32_t>> sorted(imageOf.begin(), imageOf.end());
+        sorted.insert(sorted.end(), aliases.begin(), aliases.end());
+        sort(sorted.begin(), sorted.end());
+
+        vector<SpritePackName> names;
+        string pool;
+        for (const auto& entry : sorted) {
+            names.push_back({{(uint32_t)pool.size(), (uint32_t)entry.first.size()}, entry.second});
+            pool += entry.first;
+        }
+
+        SpritePackHeader header = {};
+        header.magic = kSpritePackMagic;
+        header.version = kSpritePackVersion;
+        header.images = appendRaw(images.data(), images.size(), sizeof(SpritePackImage));
+        header.names = appendRaw(names.data(), names.size(), sizeof(SpritePackName));
+        header.strings = appendRaw(pool.data(), pool.size(), 1);
+        header.fileSize = offset;
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.close();
+        return !out.fail();
+    }
+
+    size_t aliasCount() const { return aliases.size(); }
+
+private:
+    // Sección alineada a 8 bytes
+    DatasetSection appendRaw(const void* data, size_t count, size_t elementSize) {
+        while (offset % 8) {
+            out.put(0);
+            ++offset;
+        }
+        DatasetSection s{offset, (uint32_t)count};
+        out.write(static_cast<const char*>(data), count * elementSize);
+        offset += (uint32_t)(count * elementSize);
+        return s;
+    }
+
+    ofstream out;
+    uint32_t offset = 0;
+    vector<SpritePackImage> images;
+    unordered_map<string, uint32_t> imageOf;   // Clave del archivo -> imagen
+    vector<pair<string, uint32_t>> aliases;
+};
+
+static bool loadPokedexNames(const string& filename, vector<string>& names) {
+    CsvReader csv;
+    if (!csv.open(filename)) {
+        cerr << "Error al abrir " << filename << endl;
+        return false;
+    }
+
+    vector<string_view> fields;
+    csv.nextRow(fields); // Skip header
+    while (csv.nextRow(fields)) {
+        if (fields.size() > 2) names.push_back(string(fields[2]));
+    }
+    return true;
+}
+
+// Imagen para un nombre de pokemon_data.csv que no tiene archivo propio: la de
+// la forma base ("Rattata Alolan Rattata" -> "rattata") o, si la especie solo
+// tiene imágenes de sus formas, la primera ("Deoxys Attack Forme" -> "deoxys-normal").
+// keys son las claves de los archivos, ordenadas; vacío si no hay ninguna.
+static string resolveAlias(const string& name, const vector<string>& keys) {
+    string key = spriteKey(name);
+    for (size_t dash = key.rfind('-'); dash != string::npos; dash = key.rfind('-')) {
+        key.resize(dash);
+        if (binary_search(keys.begin(), keys.end(), key)) return key;
+    }
+
+    string prefix = key + "-";
+    auto it = lower_bound(keys.begin(), keys.end(), prefix);
+    if (it != keys.end() && it->compare(0, prefix.size(), prefix) == 0) return *it;
+    return "";
+}
+
+int main(int argc, char** argv) {
+    fs::path source = argc > 1 ? argv[1] : "Pokemon_Dataset";
+    fs::path output = argc > 2 ? argv[2] : "sprites";
+    string pokedexFile = argc > 3 ? argv[3] : "pokemon_data.csv";
+
+    vector<string> pokedexNames;
+    if (!loadPokedexNames(pokedexFile, pokedexNames)) return 1;
+
+    // Orden fijo, para que el atlas generado sea reproducible
+    vector<fs::path> files;
+    for (const auto& entry : fs::directory_iterator(source)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".png") files.push_back(entry.path());
+    }
+    sort(files.begin(), files.end());
+    if (files.empty()) {
+        cerr << "No hay imágenes en " << source.string() << endl;
+        return 1;
+    }
+    fs::create_directories(output);
+
+    SpritePackWriter pack;
+    string packPath = (output / "sprites.pak").string();
+    if (!pack.open(packPath)) {
+        cerr << "Error al escribir " << packPath << endl;
+        return 1;
+    }
+
+    AtlasBuilder atlas;
+    vector<string> keys;
+    size_t skipped = 0;
+    for (const fs::path& file : files) {
+        sf::Image image;
+        if (!image.loadFromFile(file.string())) {
+            ++skipped;
+            continue;
+        }
+
+        // De la mayor a la menor, cada una reducida desde la anterior
+        string key = spriteKey(file.stem().string());
+        SpritePackImage record = {};
+        for (size_t l = kSpriteLevelCount; l-- > 0;) {
+            image = downscale(image, kSpriteLevels[l]);
+            vector<sf::Uint8> png;
+            if (!image.saveToMemory(png, "png")) {
+                cerr << "Error al codificar " << file.string() << endl;
+                return 1;
+            }
+            record.variants[l] = pack.addBlob(png);
+        }
+        pack.addImage(key, record);
+        atlas.add(key, image);
+        keys.push_back(key);
+    }
+    sort(keys.begin(), keys.end());
+
+    size_t unmatched = 0;
+    for (const string& name : pokedexNames) {
+        if (binary_search(keys.begin(), keys.end(), spriteKey(name))) continue;
+        string key = resolveAlias(name, keys);
+        if (key.empty()) {
+            ++unmatched;
+            continue;
+        }
+        pack.addAlias(name, key);
+        atlas.addAlias(name, key);
+    }
+
+    if (!pack.finish()) {
+        cerr << "Error al escribir " << packPath << endl;
+        return 1;
+    }
+    if (!atlas.write(output)) return 1;
+
+    cout << output.string() << ": " << files.size() - skipped << " imágenes en " << kSpriteLevelCount
+         << " tamaños, " << pack.aliasCount() << " alias, atlas de " << atlas.pageCount()
+         << " páginas de " << kPageSize << " px";
+    if (skipped) cout << " (" << skipped << " no se pudieron leer)";
+    cout << endl;
+    if (unmatched) cout << unmatched << " nombres de " << pokedexFile << " sin imagen" << endl;
+    return 0;
+}
@@ -0,0 +1,182 @@
+// Compila los CSV del proyecto a un único pokemon.dat que la aplicación y las
+// herramientas sin interfaz mapean en memoria al arrancar.
+//
+// Uso: compile_dataset [salida] (por defecto pokemon.dat)
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "CsvReader.hpp"
+#include "Dataset.hpp"
+#include "Learnsets.hpp"
+#include "MoveTable.hpp"
+#include "SpeciesTable.hpp"
+#include "TypeChart.hpp"
+
+using namespace std;
+
+struct PokedexRow {
+    string name;
+    PokeType type1 = PokeType::None;
+    PokeType type2 = PokeType::None;
+};
+
+static bool loadPokedexRows(const string& filename, vector<PokedexRow>& rows) {
+    CsvReader csv;
+    if (!csv.open(filename)) {
+        cerr << "Error al abrir " << filename << endl;
+        return false;
+    }
+
+    vector<string_view> fields;
+    csv.nextRow(fields); // Skip header
+
+    // id,#,Name,Type,...; Type lleva uno o dos tipos separados por espacio
+    while (csv.nextRow(fields)) {
+        if (fields.size() < 4) continue;
+
+        PokedexRow row;
+        row.name = string(fields[2]);
+        string_view types = fields[3];
+        size_t space = types.find(' ');
+        row.type1 = parseType(types.substr(0, space));
+        if (space != string_view::npos) row.type2 = parseType(types.substr(space + 1));
+        rows.push_back(row);
+    }
+
+    sort(rows.begin(), rows.end(), [](const PokedexRow& a, const PokedexRow& b) {
+        return a.name < b.name;
+    });
+    return true;
+}
+
+class DatasetWriter {
+public:
+    DatasetWriter() : bytes(sizeof(DatasetHeader), 0) {}
+
+    DatasetString intern(const string& s) {
+        DatasetString ref{(uint32_t)pool.size(), (uint32_t)s.size()};
+        pool.insert(pool.end(), s.begin(), s.end());
+        return ref;
+    }
+
+    // Añade una sección alineada a 8 bytes y devuelve su descriptor
+    template <typename T>
+    DatasetSection append(const vector<T>& items) {
+        return appendRaw(items.data(), items.size(), sizeof(T));
+    }
+
+    DatasetSection appendRaw(const void* data, size_t count, size_t elementSize) {
+        while (bytes.size() % 8) bytes.push_back(0);
+        DatasetSection s{(uint32_t)bytes.size(), (uint32_t)count};
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        bytes.insert(bytes.end(), p, p + count * elementSize);
+        return s;
+    }
+
+    bool write(const string& filename, DatasetHeader header) {
+        header.strings = appendRaw(pool.data(), pool.size(), 1);
+        header.magic = kDatasetMagic;
+        header.version = kDatasetVersion;
+        header.fileSize = (uint32_t)bytes.size();
+        memcpy(bytes.data(), &header, sizeof(header));
+
+        ofstream out(filename, ios::binary);
+        out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        return (bool)out;
+    }
+
+private:
+    vector<unsigned char> bytes;
+    vector<char> pool;
+};
+
+int main(int argc, char** argv) {
+    string output = argc > 1 ? argv[1] : "pokemon.dat";
+
+    TypeChart typeChart;
+    SpeciesTable species;
+    MoveTable moves;
+    Learnsets learnsets;
+    vector<PokedexRow> pokedex;
+    if (!typeChart.loadFromCsv("type-chart.csv") ||
+        !species.loadFromCsv("pokemon.csv") ||
+        !moves.loadFromCsv("moves.csv") ||
+        !learnsets.loadFromCsv("movesets.csv", species, moves) ||
+        !loadPokedexRows("pokemon_data.csv", pokedex)) {
+        return 1;
+    }
+
+    DatasetWriter writer;
+    DatasetHeader header = {};
+
+    vector<float> chartRows;
+    for (int d1 = 0; d1 < kTypeSlots; ++d1) {
+        for (int d2 = 0; d2 < kTypeSlots; ++d2) {
+            const float* row = typeChart.row(static_cast<PokeType>(d1), static_cast<PokeType>(d2));
+            chartRows.insert(chartRows.end(), row, row + kTypeSlots);
+        }
+    }
+    header.typeChart = writer.appendRaw(chartRows.data(), kTypeSlots * kTypeSlots, sizeof(float) * kTypeSlots);
+
+    vector<DatasetSpecies> speciesRecords;
+    for (size_t i = 0; i < species.size(); ++i) {
+        DatasetSpecies r = {};
+        r.name = writer.intern(species.names[i]);
+        r.type1 = (uint8_t)species.type1[i];
+        r.type2 = (uint8_t)species.type2[i];
+        r.hp = species.hp[i];
+        r.attack = species.attack[i];
+        r.defense = species.defense[i];
+        r.spAttack = species.spAttack[i];
+        r.spDefense = species.spDefense[i];
+        r.speed = species.speed[i];
+        speciesRecords.push_back(r);
+    }
+    header.species = writer.append(speciesRecords);
+
+    vector<DatasetMove> moveRecords;
+    for (const MoveData& m : moves) {
+        DatasetMove r = {};
+        r.name = writer.intern(m.name);
+        r.type = (uint8_t)m.type;
+        r.category = (uint8_t)m.category;
+        r.power = m.power;
+        r.accuracy = m.accuracy;
+        r.priority = m.priority;
+        r.crit = m.crit;
+        moveRecords.push_back(r);
+    }
+    header.moves = writer.append(moveRecords);
+
+    vector<DatasetPokedexEntry> pokedexRecords;
+    for (const PokedexRow& row : pokedex) {
+        DatasetPokedexEntry r = {};
+        r.name = writer.intern(row.name);
+        r.type1 = (uint8_t)row.type1;
+        r.type2 = (uint8_t)row.type2;
+        pokedexRecords.push_back(r);
+    }
+    header.pokedex = writer.append(pokedexRecords);
+
+    header.learnsetBits = writer.append(learnsets.allBits());
+    vector<DatasetLearnEntry> learnRecords;
+    for (const LearnEntry& e : learnsets.allEntries()) {
+        learnRecords.push_back({e.move, (uint8_t)e.method, e.level});
+    }
+    header.learnEntries = writer.append(learnRecords);
+    header.learnOffsets = writer.append(learnsets.offsets());
+
+    if (!writer.write(output, header)) {
+        cerr << "Error al escribir " << output << endl;
+        return 1;
+    }
+
+    cout << output << ": " << species.size() << " especies, " << moves.size() << " movimientos, "
+         << learnsets.allEntries().size() << " aprendizajes, " << pokedex.size() << " entradas de pokedex" << endl;
+    return 0;
+}
@@ -1,13 +1,36 @@
 #include <SFML/Graphics.hpp>
-#include <fstream>
 #include <iostream>
-#include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <cmath>
+#include <string_view>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <list>
+#include <thread>
+
+#include "CsvReader.hpp"
+#include "BackgroundJobs.hpp"
+#include "DamageEngine.hpp"
+#include "Dataset.hpp"
+#include "Learnsets.hpp"
+#include "LockFreeQueue.hpp"
+#include "MoveTable.hpp"
+#include "SpeciesTable.hpp"
+#include "SpriteIndex.hpp"
+#include "SpritePack.hpp"
+#include "StatCalc.hpp"
+#include "TeamOptimizer.hpp"
+#include "TeamSweep.hpp"
+#include "ThreadPool.hpp"
+#include "TopK.hpp"
+#include "TypeChart.hpp"
 
 using namespace std;
 
@@ -16,20 +39,6 @@ class MoveSelector;
 class Dropdown;
 
 // Data Structures
-struct Move {
-    string id;
-    string name;
-    string description;
-    string type;
-    string category; // "Physical", "Special" or "Status"
-    string power;
-    string accuracy;
-    string pp;
-    string z_effect;
-    string priority;
-    string crit;
-};
-
 struct Pokemon {
     string name;
     vector<string> types;
@@ -38,126 +47,269 @@ struct Pokemon {
     vector<string> stats; // Pokemon stats (defense, attack, etc.)
 };
 
-struct TypeEffectiveness {
-    string defense_type1;
-    string defense_type2;
-    unordered_map<string, float> effectiveness;
-};
-
 struct AttackResult {
     string pokemonName;
     string moveName;
     string moveType;
     float minDamage;
     float maxDamage;
+    KoChances ko;
 };
 
-// Global Resources
-class Resources {
+// Texturas de Pokemon_Dataset compartidas entre el panel de resultados y los
+// dropdowns. De cada imagen se carga la variante de sprites.pak (ver
+// build_sprites) más chica que cubre el tamaño en pantalla; sin el paquete, el
+// PNG original suelto. Los PNG se decodifican a sf::Image en hilos aparte y la subida a
+// la GPU se hace en el hilo de la ventana con upload(), así que pedir una
+// imagen nunca bloquea el frame. Cada nombre se carga una sola vez (también si
+// no existe, para no volver a intentarlo cada frame). Las texturas se reparten
+// como shared_ptr; cuando la memoria supera el presupuesto se liberan las menos
+// usadas recientemente que nadie más tenga en uso.
+class TextureCache {
 public:
-    static sf::Texture typesTexture;
-    static unordered_map<string, sf::Sprite> typeSprites;
-    static unordered_map<string, Move> movesDatabase;
-    static vector<TypeEffectiveness> typeChart;
-    static sf::Font globalFont;
+    explicit TextureCache(size_t budgetBytes) : budget(budgetBytes), decoded(1024) {}
 
-    static void loadMovesData(const string& filename) {
-        ifstream file(filename);
-        if (!file.is_open()) {
-            cerr << "Error al abrir el archivo moves.csv" << endl;
-            return;
+    // Nadie vacía ya la cola: las tareas pendientes descartan su resultado en
+    // vez de esperar sitio, y así el pool puede terminar
+    ~TextureCache() {
+        stopping = true;
+        decoder.reset();
+    }
+
+    // Antes de pedir imágenes; false si no está el paquete (se usan los archivos sueltos)
+    bool openPack(const string& filename) { return pack.open(filename); }
+
+    // La textura para mostrar a displaySize px si ya está cargada; si no, encarga
+    // su decodificación y devuelve nullptr (también si no hay imagen, ver pending())
+    shared_ptr<const sf::Texture> request(const string& name, float displaySize) {
+        unsigned level = spriteLevelFor(displaySize);
+        string key = cacheKey(name, level);
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            recent.splice(recent.begin(), recent, it->second.position);
+            return it->second.texture;
         }
 
-        string line;
-        getline(file, line); // Read header
+        if (decoding.insert(key).second) {
+            if (!decoder) decoder = make_unique<ThreadPool>(2);
+            decoder->submit([this, name, key, level]() {
+                if (stopping) return;
+                DecodedImage result;
+                result.key = key;
+                if (pack.isOpen()) {
+                    // Nombre o alias; si no está, no hay imagen y no se toca el disco
+                    int image = pack.find(name);
+                    string_view png = image >= 0 ? pack.variant(image, level) : string_view();
+                    result.ok = !png.empty() && result.image.loadFromMemory(png.data(), png.size());
+                } else {
+                    result.ok = result.image.loadFromFile("Pokemon_Dataset/" + name + ".png");
+                }
+                // Si la cola se llenó, la ventana la vacía en el siguiente frame
+                while (!decoded.push(move(result))) {
+                    if (stopping) return;
+                    this_thread::yield();
+                }
+            });
+        }
+        return nullptr;
+    }
 
-        while (getline(file, line)) {
-            stringstream ss(line);
-            Move m;
+    // La imagen se está decodificando todavía
+    bool pending(const string& name, float displaySize) const {
+        return decoding.count(cacheKey(name, spriteLevelFor(displaySize))) > 0;
+    }
 
-            getline(ss, m.id, ',');
-            getline(ss, m.name, ',');
-            getline(ss, m.type, ',');
-            getline(ss, m.category, ',');
-            getline(ss, m.power, ',');
-            getline(ss, m.accuracy, ',');
-            getline(ss, m.priority, ',');
-            getline(ss, m.crit, ',');
+    // En el hilo de la ventana, una vez por frame: sube a la GPU como mucho
+    // maxUploads imágenes ya decodificadas, para repartir el coste entre frames
+    void upload(size_t maxUploads) {
+        DecodedImage result;
+        for (size_t i = 0; i < maxUploads && decoded.pop(result); ++i) {
+            decoding.erase(result.key);
+
+            shared_ptr<sf::Texture> texture;
+            size_t bytes = 0;
+            if (result.ok) {
+                texture = make_shared<sf::Texture>();
+                if (texture->loadFromImage(result.image)) {
+                    texture->setSmooth(true);
+                    bytes = size_t(texture->getSize().x) * texture->getSize().y * 4;
+                } else {
+                    texture.reset();
+                }
+            }
 
-            movesDatabase[m.id] = m;
+            recent.push_front(result.key);
+            entries[result.key] = {texture, bytes, recent.begin()};
+            used += bytes;
         }
+        evict();
     }
 
-    static void loadTypeChart(const string& filename) {
-        ifstream file(filename);
-        if (!file.is_open()) {
-            cerr << "Error al abrir " << filename << endl;
-            return;
-        }
+    size_t bytesUsed() const { return used; }
 
-        string line;
-        getline(file, line);
-        stringstream header(line);
-        string token;
-        vector<string> attackTypes;
-
-        for (int i = 0; i < 2; i++) getline(header, token, ',');
-        while (getline(header, token, ',')) {
-            attackTypes.push_back(token);
+private:
+    struct Entry {
+        shared_ptr<const sf::Texture> texture;
+        size_t bytes;
+        list<string>::iterator position;
+    };
+
+    static string cacheKey(const string& name, unsigned level) { return name + "@" + to_string(level); }
+
+    struct DecodedImage {
+        string key;   // Nombre y variante, como en entries
+        sf::Image image;
+        bool ok = false;
+    };
+
+    void evict() {
+        auto it = recent.end();
+        while (used > budget && it != recent.begin()) {
+            --it;
+            Entry& entry = entries[*it];
+            // Solo la caché la tiene: se puede liberar
+            if (entry.texture && entry.texture.use_count() == 1) {
+                used -= entry.bytes;
+                entries.erase(*it);
+                it = recent.erase(it);
+            }
         }
+    }
 
-        while (getline(file, line)) {
-            stringstream ss(line);
-            TypeEffectiveness te;
-            
-            getline(ss, te.defense_type1, ',');
-            getline(ss, te.defense_type2, ',');
+    size_t budget;
+    size_t used = 0;
+    list<string> recent;   // Del más reciente al menos reciente
+    SpritePack pack;                       // Mapeado; solo lectura desde los hilos
+    unordered_map<string, Entry> entries;  // Por nombre y variante
+    unordered_set<string> decoding;        // Encargadas y aún no subidas
+    LockFreeQueue<DecodedImage> decoded;   // De los hilos de decodificación a la ventana
+    atomic<bool> stopping{false};          // Cerrando: los hilos dejan de publicar
+    unique_ptr<ThreadPool> decoder;        // Último: se destruye antes que la cola que usan sus tareas
+};
 
-            string effStr;
-            for (size_t i = 0; i < attackTypes.size(); i++) {
-                if (!getline(ss, effStr, ',')) break;
-                te.effectiveness[attackTypes[i]] = stof(effStr);
+// Miniaturas de todas las especies empaquetadas en unas pocas texturas por
+// build_sprites. Los sprites de un frame se acumulan en un sf::VertexArray por
+// página y se dibujan con una sola llamada por página.
+class SpriteAtlas {
+public:
+    // false si el atlas no está generado; entonces se usa TextureCache
+    bool load(const string& directory) {
+        if (!index.loadFromCsv(directory + "/atlas.csv")) return false;
+
+        pages = vector<sf::Texture>(index.pageCount());
+        for (size_t p = 0; p < pages.size(); ++p) {
+            if (!pages[p].loadFromFile(directory + "/atlas_" + to_string(p) + ".png")) {
+                pages.clear();
+                return false;
             }
-
-            typeChart.push_back(te);
+            pages[p].setSmooth(true);
         }
+        batches.assign(pages.size(), sf::VertexArray(sf::Quads));
+        return true;
+    }
+
+    // Añade la miniatura al lote de su página; false si no está en el atlas
+    bool add(const string& name, sf::Vector2f position, sf::Vector2f size) {
+        const SpriteRegion* region = pages.empty() ? nullptr : index.find(name);
+        if (!region) return false;
+
+        float u = region->x, v = region->y;
+        float w = region->width, h = region->height;
+        sf::VertexArray& batch = batches[region->page];
+        batch.append(sf::Vertex(position, sf::Vector2f(u, v)));
+        batch.append(sf::Vertex({position.x + size.x, position.y}, sf::Vector2f(u + w, v)));
+        batch.append(sf::Vertex(position + size, sf::Vector2f(u + w, v + h)));
+        batch.append(sf::Vertex({position.x, position.y + size.y}, sf::Vector2f(u, v + h)));
+        return true;
     }
 
-    static unordered_map<string, vector<string>> loadPokemonStats(const string& filename) {
-        unordered_map<string, vector<string>> statsMap;
-        ifstream file(filename);
-        if (!file.is_open()) {
-            cerr << "Error al abrir " << filename << endl;
-            return statsMap;
+    // Dibuja lo acumulado y vacía los lotes
+    void flush(sf::RenderTarget& target) {
+        for (size_t p = 0; p < batches.size(); ++p) {
+            if (batches[p].getVertexCount() == 0) continue;
+            target.draw(batches[p], sf::RenderStates(&pages[p]));
+            batches[p].clear();
         }
+    }
 
-        string line;
-        getline(file, line); // Skip header
+private:
+    SpriteIndex index;
+    vector<sf::Texture> pages;
+    vector<sf::VertexArray> batches;   // Uno por página
+};
+
+// Global Resources
+class Resources {
+public:
+    static sf::Image typesImage;
+    static sf::Texture typesTexture;
+    static unordered_map<string, sf::Sprite> typeSprites;
+    static MoveTable movesDatabase;   // Contiguo; el índice es el ID del movimiento
+    static TypeChart typeChart;
+    static SpeciesTable speciesTable;
+    static Learnsets learnsets;
+    static StatCalc statCalc;          // Estadísticas reales, memorizadas por (especie, nivel, spread)
+    static DamageEngine damageEngine;
+    static Dataset dataset;
+    static sf::Font globalFont;
+    static TextureCache speciesTextures;
+    static SpriteAtlas spriteAtlas;     // Miniaturas de los resultados
+
+    // Llena las tablas desde pokemon.dat (ver compile_dataset), ya abierto en dataset
+    static bool loadDataset() {
+        return typeChart.loadFromDataset(dataset) &&
+               speciesTable.loadFromDataset(dataset) &&
+               movesDatabase.loadFromDataset(dataset) &&
+               learnsets.loadFromDataset(dataset, speciesTable.size(), movesDatabase.size());
+    }
 
-        while (getline(file, line)) {
-            stringstream ss(line);
-            vector<string> stats;
-            string token;
+    static void loadMovesData(const string& filename) {
+        movesDatabase.loadFromCsv(filename);
+    }
 
-            while (getline(ss, token, ',')) {
-                stats.push_back(token);
-            }
+    // -1 si no existe un movimiento con ese nombre
+    static int findMove(const string& name) {
+        return movesDatabase.find(name);
+    }
 
-            if (stats.size() > 2) {
-                string name = stats[2];
-                if (!name.empty() && name.front() == '"' && name.back() == '"') {
-                    name = name.substr(1, name.size()-2);
-                }
-                statsMap[name] = stats;
+    // Necesita speciesTable y movesDatabase ya cargados
+    static void loadLearnsets(const string& filename) {
+        learnsets.loadFromCsv(filename, speciesTable, movesDatabase);
+    }
+
+    // Movimientos que puede aprender la especie, ordenados por nombre.
+    // Sin especie o sin datos de movesets.csv se ofrecen todos.
+    static vector<string> legalMoveNames(const string& species) {
+        vector<string> names;
+        int id = speciesTable.find(species);
+        bool filter = id >= 0 && learnsets.hasData(static_cast<SpeciesId>(id));
+        for (size_t m = 0; m < movesDatabase.size(); ++m) {
+            if (!filter || learnsets.canLearn(static_cast<SpeciesId>(id), static_cast<MoveId>(m))) {
+                names.push_back(movesDatabase[static_cast<MoveId>(m)].name);
             }
         }
+        sort(names.begin(), names.end());
+        return names;
+    }
 
-        return statsMap;
+    static void loadTypeChart(const string& filename) {
+        typeChart.loadFromCsv(filename);
     }
 
+    static void loadPokemonStats(const string& filename) {
+        speciesTable.loadFromCsv(filename);
+    }
+
+    // Solo decodifica la imagen; se puede llamar desde un hilo de carga
+    static void loadTypesImage(const string& filename) {
+        if (!typesImage.loadFromFile(filename)) {
+            cerr << "Error al cargar " << filename << endl;
+        }
+    }
+
+    // Sube la imagen a la GPU y recorta los sprites; debe llamarse desde el hilo de la ventana
     static void initTypeSprites() {
-        if (!typesTexture.loadFromFile("tipos.png")) {
-            cerr << "Error al cargar tipos.png" << endl;
+        if (typesImage.getSize().x == 0 || !typesTexture.loadFromImage(typesImage)) {
             return;
         }
 
@@ -190,50 +342,114 @@ public:
 
     static unordered_map<string, Pokemon> loadPokemonData(const string& filename, vector<string>& names) {
         unordered_map<string, Pokemon> pokedex;
-        ifstream file(filename);
-        string line;
+        CsvReader csv;
+        if (!csv.open(filename)) return pokedex;
 
-        getline(file, line); // Skip header
+        vector<string_view> fields;
+        csv.nextRow(fields); // Skip header
 
-        while (getline(file, line)) {
-            stringstream ss(line);
-            string id, id2, name, typesStr;
-
-            getline(ss, id, ',');
-            getline(ss, id2, ',');
-            getline(ss, name, ',');
-            getline(ss, typesStr, ',');
+        while (csv.nextRow(fields)) {
+            if (fields.size() < 4) continue;
 
             Pokemon p;
-            p.name = name;
-            names.push_back(name);
-
-            stringstream typeStream(typesStr);
-            string type;
-            while (typeStream >> type) {
-                p.types.push_back(type);
+            p.name = string(fields[2]);
+            names.push_back(p.name);
+
+            // "Grass Poison": tipos separados por espacio
+            string_view typesStr = fields[3];
+            while (!typesStr.empty()) {
+                size_t space = typesStr.find(' ');
+                if (space != 0) p.types.emplace_back(typesStr.substr(0, space));
+                if (space == string_view::npos) break;
+                typesStr.remove_prefix(space + 1);
             }
 
-            pokedex[name] = p;
+            pokedex[p.name] = p;
         }
         
         sort(names.begin(), names.end());
         return pokedex;
     }
+
+    // Mismo resultado que la versión CSV; las entradas ya vienen ordenadas por nombre
+    static unordered_map<string, Pokemon> loadPokemonData(const Dataset& ds, vector<string>& names) {
+        unordered_map<string, Pokemon> pokedex;
+        const DatasetPokedexEntry* entries = ds.pokedex();
+
+        for (size_t i = 0; i < ds.pokedexCount(); ++i) {
+            Pokemon p;
+            p.name = string(ds.str(entries[i].name));
+            names.push_back(p.name);
+
+            PokeType types[2] = {static_cast<PokeType>(entries[i].type1), static_cast<PokeType>(entries[i].type2)};
+            for (PokeType t : types) {
+                if (t != PokeType::None) p.types.push_back(typeName(t));
+            }
+
+            pokedex[p.name] = p;
+        }
+        return pokedex;
+    }
 };
 
 // Initialize static members
+sf::Image Resources::typesImage;
 sf::Texture Resources::typesTexture;
 unordered_map<string, sf::Sprite> Resources::typeSprites;
-unordered_map<string, Move> Resources::movesDatabase;
-vector<TypeEffectiveness> Resources::typeChart;
+MoveTable Resources::movesDatabase;
+TypeChart Resources::typeChart;
+SpeciesTable Resources::speciesTable;
+Learnsets Resources::learnsets;
+StatCalc Resources::statCalc(Resources::speciesTable);
+DamageEngine Resources::damageEngine(Resources::typeChart, Resources::speciesTable, Resources::movesDatabase);
+Dataset Resources::dataset;
 sf::Font Resources::globalFont;
+TextureCache Resources::speciesTextures(128 * 1024 * 1024);
+SpriteAtlas Resources::spriteAtlas;
+
+// Lanza cargas independientes en paralelo y las espera antes del primer uso
+class StartupLoader {
+public:
+    explicit StartupLoader(ThreadPool& pool) : pool(pool) {}
+
+    void add(const string& name, function<bool()> job) {
+        tasks.push_back({name, pool.submit([job]() {
+            auto start = chrono::steady_clock::now();
+            bool ok = job();
+            chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+            return make_pair(ok, elapsed.count());
+        })});
+    }
+
+    // Espera todas las cargas e informa el tiempo de cada una; false si alguna falló
+    bool wait() {
+        bool allOk = true;
+        for (auto& task : tasks) {
+            pair<bool, double> result = task.result.get();
+            cout << "Carga de " << task.name << ": " << result.second << " ms"
+                 << (result.first ? "" : " (error)") << endl;
+            allOk = allOk && result.first;
+        }
+        tasks.clear();
+        return allOk;
+    }
+
+private:
+    struct Task {
+        string name;
+        future<pair<bool, double>> result;
+    };
+
+    ThreadPool& pool;
+    vector<Task> tasks;
+};
 
 // UI Components
 class LevelInput {
 public:
-    LevelInput(float x, float y, float width, float height, sf::Font& font) 
-        : font(font), isActive(false) {
+    LevelInput(float x, float y, float width, float height, sf::Font& font,
+               const string& caption = "Nivel: ", int defaultValue = 50)
+        : font(font), isActive(false), level(defaultValue), defaultValue(defaultValue) {
         box.setPosition(x, y);
         box.setSize({width, height});
         box.setFillColor(sf::Color(200, 200, 200));
@@ -241,13 +457,13 @@ public:
         box.setOutlineColor(sf::Color::Black);
 
         label.setFont(font);
-        label.setString("Nivel: ");
+        label.setString(caption);
         label.setCharacterSize(14);
         label.setPosition(x - 50, y + 5);
         label.setFillColor(sf::Color::Black);
 
         text.setFont(font);
-        text.setString("50");
+        text.setString(to_string(defaultValue));
         text.setCharacterSize(14);
         text.setPosition(x + 5, y + 5);
         text.setFillColor(sf::Color::Black);
@@ -280,12 +496,20 @@ public:
                     inputText += static_cast<char>(event.text.unicode);
                 }
             }
-            text.setString(inputText.empty() ? "50" : inputText);
+            text.setString(inputText.empty() ? to_string(defaultValue) : inputText);
+            level = inputText.empty() ? defaultValue : stoi(inputText);
         }
     }
 
-    string getLevel() const {
-        return inputText.empty() ? "50" : inputText;
+    int getLevel() const {
+        return level;
+    }
+
+    // Como si el usuario lo hubiera escrito
+    void setLevel(int value) {
+        inputText = to_string(value);
+        level = value;
+        text.setString(inputText);
     }
 
 private:
@@ -295,8 +519,27 @@ private:
     sf::Font& font;
     bool isActive;
     string inputText;
+    int level;
+    int defaultValue;
 };
 
+// Barra de desplazamiento de una lista: visible de total filas, empezando en start
+void layoutScrollbar(sf::RectangleShape& scrollbar, sf::RectangleShape& thumb, float x, float y,
+                     float height, size_t total, int visible, int start) {
+    float thumbHeight = height * visible / (float)total;
+    float thumbY = y + (height - thumbHeight) * start / (float)(total - visible);
+
+    scrollbar.setSize({8, height});
+    scrollbar.setPosition(x, y);
+    scrollbar.setFillColor(sf::Color(200, 200, 200));
+
+    thumb.setSize({8, thumbHeight});
+    thumb.setPosition(x, thumbY);
+    thumb.setFillColor(sf::Color(120, 120, 120));
+}
+
+// Selector de hasta 4 ataques. Los textos y recuadros de las filas se arman en
+// rebuild() y se reutilizan entre frames; solo se rearman cuando algo marca dirty
 class MoveSelector {
 public:
     MoveSelector(float x, float y, float width, float height, const vector<string>& moves, sf::Font& font)
@@ -331,59 +574,21 @@ public:
         window.draw(buttonText);
 
         if (isActive) {
+            if (dirty) rebuild();
             window.draw(background);
             window.draw(title);
 
-            // Draw selected moves
-            for (size_t i = 0; i < selectedMoves.size(); ++i) {
-                sf::Text moveText;
-                moveText.setFont(font);
-                moveText.setString(to_string(i+1) + ": " + selectedMoves[i].first);
-                moveText.setCharacterSize(14);
-                moveText.setPosition(background.getPosition().x + 5, background.getPosition().y + 30 + i * 20);
-                moveText.setFillColor(sf::Color::Black);
-                window.draw(moveText);
-
-                if (Resources::typeSprites.count(selectedMoves[i].second)) {
-                    sf::Sprite typeSprite = Resources::typeSprites[selectedMoves[i].second];
-                    typeSprite.setPosition(background.getPosition().x + 150, background.getPosition().y + 30 + i * 20);
-                    window.draw(typeSprite);
-                }
-            }
+            for (const sf::Text& text : selectedTexts) window.draw(text);
+            for (const sf::Sprite& sprite : selectedTypes) window.draw(sprite);
 
-            // Draw available moves if less than 4 selected
+            // Lista de ataques disponibles si hay menos de 4 elegidos
             if (selectedMoves.size() < 4) {
-                for (int i = 0; i < maxVisible && startIndex + i < filteredMoves.size(); ++i) {
-                    sf::RectangleShape optionBox;
-                    optionBox.setSize({background.getSize().x, 20});
-                    optionBox.setPosition(background.getPosition().x, background.getPosition().y + 110 + i * 20);
-                    optionBox.setFillColor(i == selectedIndex ? sf::Color(180, 180, 250) : sf::Color(240, 240, 240));
-                    window.draw(optionBox);
-
-                    sf::Text option;
-                    option.setFont(font);
-                    option.setString(filteredMoves[startIndex + i]);
-                    option.setCharacterSize(14);
-                    option.setFillColor(sf::Color::Black);
-                    option.setPosition(background.getPosition().x + 5, background.getPosition().y + 110 + i * 20 + 3);
-                    window.draw(option);
+                for (size_t i = 0; i < optionBoxes.size(); ++i) {
+                    window.draw(optionBoxes[i]);
+                    window.draw(optionTexts[i]);
                 }
-
-                if (filteredMoves.size() > maxVisible) {
-                    float scrollbarHeight = maxVisible * 20;
-                    float thumbHeight = scrollbarHeight * maxVisible / (float)filteredMoves.size();
-                    float thumbY = background.getPosition().y + 110 + (scrollbarHeight - thumbHeight) * startIndex / (float)(filteredMoves.size() - maxVisible);
-
-                    sf::RectangleShape scrollbar;
-                    scrollbar.setSize({8, scrollbarHeight});
-                    scrollbar.setPosition(background.getPosition().x + background.getSize().x - 8, background.getPosition().y + 110);
-                    scrollbar.setFillColor(sf::Color(200, 200, 200));
+                if (showScrollbar) {
                     window.draw(scrollbar);
-
-                    sf::RectangleShape thumb;
-                    thumb.setSize({8, thumbHeight});
-                    thumb.setPosition(scrollbar.getPosition().x, thumbY);
-                    thumb.setFillColor(sf::Color(120, 120, 120));
                     window.draw(thumb);
                 }
             }
@@ -395,20 +600,15 @@ public:
             if (button.getGlobalBounds().contains(mousePos)) {
                 isActive = !isActive;
                 selectedIndex = -1;
+                dirty = true;
             } else if (isActive && selectedMoves.size() < 4) {
                 for (int i = 0; i < maxVisible && startIndex + i < filteredMoves.size(); ++i) {
                     sf::FloatRect optionBounds(background.getPosition().x, background.getPosition().y + 110 + i * 20, 
                                             background.getSize().x, 20);
                     if (optionBounds.contains(mousePos)) {
-                        string moveName = filteredMoves[startIndex + i];
-                        string moveType;
-                        for (const auto& pair : Resources::movesDatabase) {
-                            if (pair.second.name == moveName) {
-                                moveType = pair.second.type;
-                                break;
-                            }
-                        }
-                        selectedMoves.emplace_back(moveName, moveType);
+                        int moveId = Resources::findMove(filteredMoves[startIndex + i]);
+                        if (moveId >= 0) selectedMoves.push_back(moveId);
+                        dirty = true;
                         break;
                     }
                 }
@@ -418,9 +618,9 @@ public:
         if (isActive && event.type == sf::Event::MouseWheelScrolled) {
             if (selectedMoves.size() < 4) {
                 startIndex -= (int)event.mouseWheelScroll.delta;
-                if (startIndex < 0) startIndex = 0;
-                if (startIndex > (int)filteredMoves.size() - maxVisible)
-                    startIndex = (int)filteredMoves.size() - maxVisible;
+                // El mínimo al final: con menos filas que maxVisible el máximo es negativo
+                startIndex = max(0, min(startIndex, (int)filteredMoves.size() - maxVisible));
+                dirty = true;
             }
         }
 
@@ -457,13 +657,70 @@ public:
             }
         }
         startIndex = 0;
+        dirty = true;
     }
 
-    const vector<pair<string, string>>& getSelectedMoves() const {
+    const vector<int>& getSelectedMoves() const {
         return selectedMoves;
     }
 
+    // Cambia la lista ofrecida; se conservan los ataques elegidos que sigan en ella
+    void setMoves(const vector<string>& moves) {
+        allMoves = moves;
+        selectedMoves.erase(remove_if(selectedMoves.begin(), selectedMoves.end(), [&](int id) {
+            return !binary_search(allMoves.begin(), allMoves.end(), Resources::movesDatabase[id].name);
+        }), selectedMoves.end());
+        filterMoves();
+    }
+
+    void setSelectedMoves(const vector<int>& moves) {
+        selectedMoves = moves;
+        dirty = true;
+    }
+
 private:
+    void rebuild() {
+        float x = background.getPosition().x;
+        float y = background.getPosition().y;
+
+        selectedTexts.clear();
+        selectedTypes.clear();
+        for (size_t i = 0; i < selectedMoves.size(); ++i) {
+            const MoveData& move = Resources::movesDatabase[selectedMoves[i]];
+            sf::Text moveText(to_string(i + 1) + ": " + move.name, font, 14);
+            moveText.setPosition(x + 5, y + 30 + i * 20);
+            moveText.setFillColor(sf::Color::Black);
+            selectedTexts.push_back(moveText);
+
+            auto sprite = Resources::typeSprites.find(typeName(move.type));
+            if (sprite != Resources::typeSprites.end()) {
+                selectedTypes.push_back(sprite->second);
+                selectedTypes.back().setPosition(x + 150, y + 30 + i * 20);
+            }
+        }
+
+        optionBoxes.clear();
+        optionTexts.clear();
+        for (int i = 0; i < maxVisible && startIndex + i < (int)filteredMoves.size(); ++i) {
+            sf::RectangleShape optionBox({background.getSize().x, 20});
+            optionBox.setPosition(x, y + 110 + i * 20);
+            optionBox.setFillColor(i == selectedIndex ? sf::Color(180, 180, 250) : sf::Color(240, 240, 240));
+            optionBoxes.push_back(optionBox);
+
+            sf::Text option(filteredMoves[startIndex + i], font, 14);
+            option.setFillColor(sf::Color::Black);
+            option.setPosition(x + 5, y + 110 + i * 20 + 3);
+            optionTexts.push_back(option);
+        }
+
+        showScrollbar = (int)filteredMoves.size() > maxVisible;
+        if (showScrollbar) {
+            layoutScrollbar(scrollbar, thumb, x + background.getSize().x - 8, y + 110, maxVisible * 20.0f,
+                            filteredMoves.size(), maxVisible, startIndex);
+        }
+        dirty = false;
+    }
+
     sf::RectangleShape background;
     sf::RectangleShape button;
     sf::Text title;
@@ -471,18 +728,27 @@ private:
     sf::Font& font;
     vector<string> allMoves;
     vector<string> filteredMoves;
-    vector<pair<string, string>> selectedMoves;
+    vector<int> selectedMoves; // IDs en Resources::movesDatabase
     bool isActive;
     int selectedIndex;
     int startIndex;
     const int maxVisible;
     string searchText;
+
+    bool dirty = true;
+    vector<sf::Text> selectedTexts;
+    vector<sf::Sprite> selectedTypes;
+    vector<sf::RectangleShape> optionBoxes;
+    vector<sf::Text> optionTexts;
+    bool showScrollbar = false;
+    sf::RectangleShape scrollbar;
+    sf::RectangleShape thumb;
 };
 
 class Dropdown {
 public:
     Dropdown(float x, float y, float width, float height, const vector<string>& items, sf::Font& font)
-    : allItems(items), filteredItems(items), expanded(false), selectedIndex(-1), 
+    : allItems(items), filteredItems(items), expanded(false),
       startIndex(0), maxVisible(7), font(font), isTyping(false), 
       typingText(""), typingClock(), lastTypingTime(0) {
     
@@ -498,80 +764,57 @@ public:
 
     image.setPosition(x, y + height + 5); 
 
+    // Mientras la imagen se decodifica en segundo plano
+    placeholder.setSize({imageSize(), imageSize()});
+    placeholder.setPosition(image.getPosition());
+    placeholder.setFillColor(sf::Color(200, 200, 200, 120));
+
     levelInput = make_unique<LevelInput>(x, y + height + 200, 50, 25, font);
 
-    vector<string> moveNames;
-    for (const auto& pair : Resources::movesDatabase) {
-        moveNames.push_back(pair.second.name);
-    }
-    sort(moveNames.begin(), moveNames.end());
+    vector<string> moveNames = Resources::legalMoveNames("");
     // Cambio aquí - nueva posición Y para el MoveSelector
     moveSelector = make_unique<MoveSelector>(x, y + height+20, width, 200, moveNames, font);
 }
 
     void draw(sf::RenderWindow& window) {
+        if (dirty) rebuild();
         window.draw(box);
         window.draw(label);
 
         if (isTyping) {
-            sf::Text typingDisplay;
-            typingDisplay.setFont(font);
-            typingDisplay.setString(typingText + "_");
-            typingDisplay.setCharacterSize(14);
-            typingDisplay.setFillColor(sf::Color::Black);
-            typingDisplay.setPosition(box.getPosition().x + 5, box.getPosition().y + 5);
             window.draw(typingDisplay);
         }
 
         if (expanded) {
-            for (int i = 0; i < maxVisible && startIndex + i < filteredItems.size(); ++i) {
-                sf::RectangleShape optionBox;
-                optionBox.setSize({box.getSize().x, box.getSize().y});
-                optionBox.setPosition(box.getPosition().x, box.getPosition().y + box.getSize().y * (i + 1));
-                optionBox.setFillColor(sf::Color(220, 220, 220));
-                window.draw(optionBox);
-
-                sf::Text option;
-                option.setFont(font);
-                option.setString(filteredItems[startIndex + i]);
-                option.setCharacterSize(14);
-                option.setFillColor(sf::Color::Black);
-                option.setPosition(box.getPosition().x + 5, box.getPosition().y + box.getSize().y * (i + 1) + 5);
-                window.draw(option);
+            for (size_t i = 0; i < optionTexts.size(); ++i) {
+                // Se adelanta la decodificación de las filas visibles para que el clic sea inmediato
+                Resources::speciesTextures.request(filteredItems[startIndex + i], imageSize());
+                window.draw(optionBoxes[i]);
+                window.draw(optionTexts[i]);
             }
 
-            if (filteredItems.size() > maxVisible) {
-                float scrollbarHeight = maxVisible * box.getSize().y;
-                float thumbHeight = scrollbarHeight * maxVisible / (float)filteredItems.size();
-                float thumbY = box.getPosition().y + box.getSize().y + (scrollbarHeight - thumbHeight) * startIndex / (float)(filteredItems.size() - maxVisible);
-
-                sf::RectangleShape scrollbar;
-                scrollbar.setSize({8, scrollbarHeight});
-                scrollbar.setPosition(box.getPosition().x + box.getSize().x - 8, box.getPosition().y + box.getSize().y);
-                scrollbar.setFillColor(sf::Color(200, 200, 200));
+            if (showScrollbar) {
                 window.draw(scrollbar);
-
-                sf::RectangleShape thumb;
-                thumb.setSize({8, thumbHeight});
-                thumb.setPosition(scrollbar.getPosition().x, thumbY);
-                thumb.setFillColor(sf::Color(120, 120, 120));
                 window.draw(thumb);
             }
         }
         
+        if (!selectedImage.empty() && !texture) {
+            texture = Resources::speciesTextures.request(selectedImage, imageSize());
+            if (texture) {
+                applyTexture();
+            } else if (!Resources::speciesTextures.pending(selectedImage, imageSize())) {
+                selectedImage.clear();   // No hay imagen para este Pokémon
+            }
+        }
+
         if (!selectedImage.empty()) {
-            window.draw(image);
-            
-            float startX = image.getPosition().x;
-            float startY = image.getPosition().y + image.getGlobalBounds().height + 5;
-            
-            for (size_t i = 0; i < currentTypes.size(); ++i) {
-                if (Resources::typeSprites.count(currentTypes[i])) {
-                    sf::Sprite typeSprite = Resources::typeSprites[currentTypes[i]];
-                    typeSprite.setPosition(startX + i * 50, startY);
-                    window.draw(typeSprite);
-                }
+            if (texture) {
+                window.draw(image);
+            } else {
+                window.draw(placeholder);
             }
+            for (const sf::Sprite& sprite : typeIcons) window.draw(sprite);
 
             levelInput->draw(window);
             moveSelector->draw(window);
@@ -589,6 +832,7 @@ public:
                     typingText = "";
                     typingClock.restart();
                     lastTypingTime = 0;
+                    dirty = true;
                 } else {
                     expanded = !expanded;
                     currentlyExpanded = expanded ? this : nullptr;
@@ -597,6 +841,7 @@ public:
                         typingText = "";
                         typingClock.restart();
                         lastTypingTime = 0;
+                        dirty = true;
                     }
                 }
             } else if (expanded) {
@@ -604,12 +849,13 @@ public:
                     sf::FloatRect optionBounds(box.getPosition().x, box.getPosition().y + box.getSize().y * (i + 1), 
                                             box.getSize().x, box.getSize().y);
                     if (optionBounds.contains(mousePos)) {
-                        label.setString(filteredItems[startIndex + i]);
-                        selectedIndex = startIndex + i;
+                        selectedItem = filteredItems[startIndex + i];
+                        label.setString(selectedItem);
                         expanded = false;
                         isTyping = false;
                         currentlyExpanded = nullptr;
-                        loadImage(filteredItems[selectedIndex]);
+                        loadImage(selectedItem);
+                        moveSelector->setMoves(Resources::legalMoveNames(selectedItem));
                         break;
                     }
                 }
@@ -624,9 +870,9 @@ public:
                 (mousePos.y > box.getPosition().y + box.getSize().y && 
                  mousePos.y < box.getPosition().y + box.getSize().y * (maxVisible + 1))) {
                 startIndex -= (int)event.mouseWheelScroll.delta;
-                if (startIndex < 0) startIndex = 0;
-                if (startIndex > (int)filteredItems.size() - maxVisible)
-                    startIndex = (int)filteredItems.size() - maxVisible;
+                // El mínimo al final: con menos filas que maxVisible el máximo es negativo
+                startIndex = max(0, min(startIndex, (int)filteredItems.size() - maxVisible));
+                dirty = true;
             }
         }
 
@@ -677,55 +923,115 @@ public:
             }
         }
         startIndex = 0;
+        dirty = true;
     }
 
+    // No bloquea: si la imagen no está cargada, draw() muestra un recuadro hasta que llega
     void loadImage(const string& name) {
-        string filename = "Pokemon_Dataset/" + name + ".png";
-        if (texture.loadFromFile(filename)) {
-            image.setTexture(texture);
-            if (box.getPosition().x < 300) {
-                image.setScale(400.0f / texture.getSize().x, 400.0f / texture.getSize().y);
-            } else {
-                image.setScale(150.0f / texture.getSize().x, 150.0f / texture.getSize().y);
-            }
-            selectedImage = filename;
-        } else {
-            selectedImage.clear();
-        }
+        selectedImage = name;
+        texture = Resources::speciesTextures.request(name, imageSize());
+        if (texture) applyTexture();
     }
 
+    // Los íconos se colocan aquí una vez, bajo la imagen
     void setTypes(const vector<string>& types) {
         currentTypes = types;
+        typeIcons.clear();
+        float startX = image.getPosition().x;
+        float startY = image.getPosition().y + imageSize() + 5;
+        for (size_t i = 0; i < currentTypes.size(); ++i) {
+            auto sprite = Resources::typeSprites.find(currentTypes[i]);
+            if (sprite == Resources::typeSprites.end()) continue;
+            typeIcons.push_back(sprite->second);
+            typeIcons.back().setPosition(startX + i * 50, startY);
+        }
     }
 
     string getSelectedItem() const {
-        if (selectedIndex >= 0 && selectedIndex < filteredItems.size())
-            return filteredItems[selectedIndex];
-        return "";
+        return selectedItem;
     }
 
-    string getLevel() const {
-        return levelInput ? levelInput->getLevel() : "50";
+    int getLevel() const {
+        return levelInput ? levelInput->getLevel() : 50;
     }
 
-    const vector<pair<string, string>>& getMoves() const {
+    const vector<int>& getMoves() const {
         return moveSelector ? moveSelector->getSelectedMoves() : emptyMoves;
     }
 
+    // Elige un Pokémon, su nivel y sus ataques como si lo hubiera hecho el usuario;
+    // false si no está en la lista
+    bool select(const string& name, int level, const vector<int>& moves) {
+        auto it = find(allItems.begin(), allItems.end(), name);
+        if (it == allItems.end()) return false;
+
+        filteredItems = allItems;
+        selectedItem = name;
+        startIndex = 0;
+        dirty = true;
+        label.setString(name);
+        levelInput->setLevel(level);
+        loadImage(name);
+        moveSelector->setMoves(Resources::legalMoveNames(name));
+        moveSelector->setSelectedMoves(moves);
+        return true;
+    }
+
 private:
+    // Lado con el que se muestra la imagen: grande para el defensor, chica a la derecha
+    float imageSize() const { return box.getPosition().x < 300 ? 400.0f : 150.0f; }
+
+    void applyTexture() {
+        image.setTexture(*texture, true);
+        image.setScale(imageSize() / texture->getSize().x, imageSize() / texture->getSize().y);
+    }
+
+    // Filas visibles y texto tecleado; draw() lo llama solo si algo marcó dirty
+    void rebuild() {
+        sf::Vector2f position = box.getPosition();
+        sf::Vector2f size = box.getSize();
+
+        typingDisplay = sf::Text(typingText + "_", font, 14);
+        typingDisplay.setFillColor(sf::Color::Black);
+        typingDisplay.setPosition(position.x + 5, position.y + 5);
+
+        optionBoxes.clear();
+        optionTexts.clear();
+        for (int i = 0; i < maxVisible && startIndex + i < (int)filteredItems.size(); ++i) {
+            sf::RectangleShape optionBox(size);
+            optionBox.setPosition(position.x, position.y + size.y * (i + 1));
+            optionBox.setFillColor(sf::Color(220, 220, 220));
+            optionBoxes.push_back(optionBox);
+
+            sf::Text option(filteredItems[startIndex + i], font, 14);
+            option.setFillColor(sf::Color::Black);
+            option.setPosition(position.x + 5, position.y + size.y * (i + 1) + 5);
+            optionTexts.push_back(option);
+        }
+
+        showScrollbar = (int)filteredItems.size() > maxVisible;
+        if (showScrollbar) {
+            layoutScrollbar(scrollbar, thumb, position.x + size.x - 8, position.y + size.y, maxVisible * size.y,
+                            filteredItems.size(), maxVisible, startIndex);
+        }
+        dirty = false;
+    }
+
     sf::RectangleShape box;
     sf::Text label;
     vector<string> allItems;
     vector<string> filteredItems;
+    string selectedItem;   // Por nombre: filtrar la lista no cambia la elección
     bool expanded;
-    int selectedIndex;
     int startIndex;
     int maxVisible;
     sf::Font& font;
-    sf::Texture texture;
+    shared_ptr<const sf::Texture> texture;   // De Resources::speciesTextures
     sf::Sprite image;
     string selectedImage;
+    sf::RectangleShape placeholder;
     vector<string> currentTypes;
+    vector<sf::Sprite> typeIcons;   // De currentTypes, ya posicionados
     
     bool isTyping;
     string typingText;
@@ -734,10 +1040,18 @@ private:
 
     unique_ptr<LevelInput> levelInput;
     unique_ptr<MoveSelector> moveSelector;
-    static const vector<pair<string, string>> emptyMoves;
+    static const vector<int> emptyMoves;
+
+    bool dirty = true;
+    sf::Text typingDisplay;
+    vector<sf::RectangleShape> optionBoxes;
+    vector<sf::Text> optionTexts;
+    bool showScrollbar = false;
+    sf::RectangleShape scrollbar;
+    sf::RectangleShape thumb;
 };
 
-const vector<pair<string, string>> Dropdown::emptyMoves;
+const vector<int> Dropdown::emptyMoves;
 
 // Helper Functions
 void mostrarTipos(const vector<string>& types, int pokemonNum, Dropdown& dropdown) {
@@ -748,257 +1062,444 @@ void mostrarTipos(const vector<string>& types, int pokemonNum, Dropdown& dropdow
     cout << endl;
 }
 
-void drawResults(sf::RenderWindow& window, const vector<AttackResult>& results, sf::Font& font) {
-    if (results.empty()) return;
+// "OHKO 38%", "2HKO 100%"...: el menor número de golpes con probabilidad de KO
+string koLabel(const KoChances& ko) {
+    const double chances[3] = {ko.ohko, ko.twoHko, ko.threeHko};
+    const char* names[3] = {"OHKO", "2HKO", "3HKO"};
+    for (int i = 0; i < 3; ++i) {
+        if (chances[i] > 0.0) {
+            return string(names[i]) + " " + to_string((int)round(chances[i] * 100)) + "%";
+        }
+    }
+    return "";
+}
 
-    float startX = 1200;
-    float startY = 100;
-    float lineHeight = 30;
+bool sameAttackResults(const vector<AttackResult>& a, const vector<AttackResult>& b) {
+    return equal(a.begin(), a.end(), b.begin(), b.end(), [](const AttackResult& x, const AttackResult& y) {
+        return x.pokemonName == y.pokemonName && x.moveName == y.moveName &&
+               x.minDamage == y.minDamage && x.maxDamage == y.maxDamage &&
+               x.ko.ohko == y.ko.ohko && x.ko.twoHko == y.ko.twoHko && x.ko.threeHko == y.ko.threeHko;
+    });
+}
 
-    sf::Text title("Mejores ataques:", font, 20);
-    title.setPosition(startX, startY - 40);
-    title.setFillColor(sf::Color::Black);
-    window.draw(title);
+// Panel de mejores ataques. Los textos se arman solo cuando cambian los
+// resultados o el estado del cálculo; las imágenes se piden en cada frame
+// porque pueden llegar más tarde (ver TextureCache).
+class ResultsPanel {
+public:
+    explicit ResultsPanel(sf::Font& font) : font(font) {}
+
+    // calculando: aún faltan slots por llegar; se muestran los que ya están
+    void draw(sf::RenderWindow& window, const vector<AttackResult>& results, bool calculando = false) {
+        if (results.empty() && !calculando) return;
+        if (!built || calculando != shownCalculando || !sameAttackResults(results, shown)) rebuild(results, calculando);
+
+        window.draw(title);
+        for (const sf::Text& text : texts) window.draw(text);
+
+        for (size_t i = 0; i < shown.size(); ++i) {
+            // Del atlas se dibujan todas juntas al final; si no está, de la caché
+            sf::Vector2f spritePosition(startX + 300, startY + i * lineHeight);
+            if (!Resources::spriteAtlas.add(shown[i].pokemonName, spritePosition, {50.0f, 50.0f})) {
+                shared_ptr<const sf::Texture> pokemonTexture = Resources::speciesTextures.request(shown[i].pokemonName, 50.0f);
+                if (pokemonTexture) {
+                    sf::Sprite pokemonSprite(*pokemonTexture);
+                    pokemonSprite.setPosition(spritePosition);
+                    pokemonSprite.setScale(50.0f / pokemonTexture->getSize().x, 50.0f / pokemonTexture->getSize().y);
+                    window.draw(pokemonSprite);
+                }
+            }
+        }
+        Resources::spriteAtlas.flush(window);
+    }
 
-    for (size_t i = 0; i < results.size(); ++i) {
-        const auto& result = results[i];
+private:
+    void rebuild(const vector<AttackResult>& results, bool calculando) {
+        shown = results;
+        shownCalculando = calculando;
+        built = true;
 
-        sf::Text moveText(result.moveName, font, 16);
-        moveText.setPosition(startX, startY + i * lineHeight);
-        moveText.setFillColor(sf::Color::Black);
-        window.draw(moveText);
+        title = sf::Text(calculando ? "Mejores ataques (calculando...)" : "Mejores ataques:", font, 20);
+        title.setPosition(startX, startY - 40);
+        title.setFillColor(sf::Color::Black);
 
-        string damageStr = to_string((int)result.minDamage) + "-" + to_string((int)result.maxDamage);
-        sf::Text damageText(damageStr, font, 16);
-        damageText.setPosition(startX + 200, startY + i * lineHeight);
-        damageText.setFillColor(sf::Color::Black);
-        window.draw(damageText);
-        
-        sf::Texture pokemonTexture;
-        if (pokemonTexture.loadFromFile("Pokemon_Dataset/" + result.pokemonName + ".png")) {
-            sf::Sprite pokemonSprite(pokemonTexture);
-            pokemonSprite.setPosition(startX + 300, startY + i * lineHeight);
-            pokemonSprite.setScale(50.0f / pokemonTexture.getSize().x, 50.0f / pokemonTexture.getSize().y);
-            window.draw(pokemonSprite);
+        texts.clear();
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& result = results[i];
+            float y = startY + i * lineHeight;
+
+            sf::Text moveText(result.moveName, font, 16);
+            moveText.setPosition(startX, y);
+            texts.push_back(moveText);
+
+            string damageStr = to_string((int)result.minDamage) + "-" + to_string((int)result.maxDamage);
+            sf::Text damageText(damageStr, font, 16);
+            damageText.setPosition(startX + 200, y);
+            texts.push_back(damageText);
+
+            sf::Text koText(koLabel(result.ko), font, 14);
+            koText.setPosition(startX + 360, y);
+            texts.push_back(koText);
         }
+        for (sf::Text& text : texts) text.setFillColor(sf::Color::Black);
     }
-}
-vector<AttackResult> procesar(Dropdown& mainDropdown, vector<Dropdown>& rightDropdowns, 
-             const unordered_map<string, Pokemon>& pokedex,
-             const unordered_map<string, vector<string>>& pokemonStats) {
-    vector<AttackResult> results;
-    string mainName = mainDropdown.getSelectedItem();
-    
-    auto mainIt = pokedex.find(mainName);
-    if (mainIt == pokedex.end()) return results;
 
-    for (size_t i = 0; i < rightDropdowns.size(); ++i) {
-        string name = rightDropdowns[i].getSelectedItem();
-        if (name.empty()) continue;
+    const float startX = 1200;
+    const float startY = 100;
+    const float lineHeight = 30;
 
-        auto it = pokedex.find(name);
-        if (it == pokedex.end()) continue;
+    sf::Font& font;
+    bool built = false;
+    vector<AttackResult> shown;
+    bool shownCalculando = false;
+    sf::Text title;
+    vector<sf::Text> texts;
+};
 
-        const auto& moves = rightDropdowns[i].getMoves();
-        if (moves.empty()) continue;
+// Cantidad de ataques que se muestran en el panel de resultados
+const size_t kResultsShown = 10;
+// Cantidad de atacantes recomendados contra el defensor
+const size_t kCountersShown = 8;
 
-        // Obtener el nivel del Pokémon atacante actual (de la derecha)
-        string attackerLevel = rightDropdowns[i].getLevel();
+// Filas de la tabla de amenazas
+const size_t kThreatsShown = 12;
 
-        for (const auto& movePair : moves) {
-            auto moveIt = find_if(Resources::movesDatabase.begin(), Resources::movesDatabase.end(),
-                [&](const pair<string, Move>& m) { return m.second.name == movePair.first; });
-            
-            if (moveIt != Resources::movesDatabase.end()) {
-                Pokemon atacante;
-                atacante.name = name;  // Nombre del atacante (derecha)
-                atacante.level = attackerLevel;  // Nivel específico de este atacante
-                atacante.types = it->second.types;  // Tipos del atacante
-
-                auto defensorStats = pokemonStats.find(mainName);  // Estadísticas del defensor (izquierda)
-                if (defensorStats == pokemonStats.end()) continue;
-
-                auto atacanteStats = pokemonStats.find(name);  // Estadísticas del atacante (derecha)
-                if (atacanteStats == pokemonStats.end()) continue;
-
-                int N = std::stoi(atacante.level);  // Usamos el nivel del atacante
-                int A, D;
-                if (moveIt->second.category == "Physical") {
-                    string AA = atacanteStats->second[11];
-                    string BB = defensorStats->second[13];
-                    A = std::stoi(AA);
-                    D = std::stoi(BB);
-                } else if (moveIt->second.category == "Special") {
-                    string AA = atacanteStats->second[12];
-                    string BB = defensorStats->second[14];
-                    A = std::stoi(AA);
-                    D = std::stoi(BB);
-                } else {
-                    continue;
-                }
+// Defensores a los que el equipo no llega al umbral, del menos dañado al más
+// dañado. Como ResultsPanel, las filas se arman solo cuando cambian.
+class ThreatsPanel {
+public:
+    explicit ThreatsPanel(sf::Font& font) : font(font) {}
 
-                string PP = moveIt->second.power;
-                if (PP.empty()) PP = "0";
-                int P = std::stoi(PP);
+    void draw(sf::RenderWindow& window, const vector<DefenderThreat>& threats, int threshold,
+              bool calculando = false) {
+        if (!built || threshold != shownThreshold || calculando != shownCalculando || !sameThreats(threats)) {
+            rebuild(threats, threshold, calculando);
+        }
+        window.draw(title);
+        for (const sf::Text& text : texts) window.draw(text);
+    }
 
-                float B = 1.0f;
-                for (const auto& tipo : atacante.types) {
-                    if (tipo == moveIt->second.type) {
-                        B = 1.5f;
-                        break;
-                    }
-                }
+private:
+    // Solo importan el total (va en el título) y las filas visibles
+    bool sameThreats(const vector<DefenderThreat>& threats) const {
+        if (threats.size() != shownCount) return false;
+        size_t rows = min(threats.size(), kThreatsShown);
+        return equal(threats.begin(), threats.begin() + rows, shown.begin(), shown.end(),
+                     [](const DefenderThreat& a, const DefenderThreat& b) {
+            return a.defender == b.defender && a.bestPercent == b.bestPercent &&
+                   a.attacker == b.attacker && a.move == b.move;
+        });
+    }
 
-                // Calcular efectividad del ataque (E)
-                float E = 1.0f;
-                const string& attackType = movePair.second; // Tipo del movimiento del atacante
-                const vector<string>& defenseTypes = mainIt->second.types; // Tipos del defensor (izquierda)
-
-                // 1. Obtener los nombres de los tipos de ataque (cabecera)
-                static vector<string> attackTypeHeaders = [](){
-                    vector<string> headers;
-                    ifstream file("type-chart.csv");
-                    string line;
-                    if (getline(file, line)) {
-                        stringstream ss(line);
-                        string token;
-                        getline(ss, token, ','); // Saltar defense-type1
-                        getline(ss, token, ','); // Saltar defense-type2
-                        while (getline(ss, token, ',')) {
-                            headers.push_back(token);
-                        }
-                    }
-                    return headers;
-                }();
-
-                // 2. Buscar la fila correspondiente a los tipos del defensor
-                vector<string> defenseRow;
-                bool foundRow = false;
-
-                ifstream file("type-chart.csv");
-                string line;
-                getline(file, line); // Saltar cabecera
-
-                while (getline(file, line)) {
-                    stringstream ss(line);
-                    string type1, type2;
-                    getline(ss, type1, ',');
-                    getline(ss, type2, ',');
-
-                    if (defenseTypes.size() == 1 && type1 == defenseTypes[0] && type2.empty()) {
-                        // Caso de un solo tipo
-                        defenseRow.push_back(line);
-                        foundRow = true;
-                        break;
-                    }
-                    else if (defenseTypes.size() == 2 && 
-                            ((type1 == defenseTypes[0] && type2 == defenseTypes[1]) ||
-                            (type1 == defenseTypes[1] && type2 == defenseTypes[0]))) {
-                        // Caso de dos tipos
-                        defenseRow.push_back(line);
-                        foundRow = true;
-                        break;
-                    }
-                }
+    void rebuild(const vector<DefenderThreat>& threats, int threshold, bool calculando) {
+        const SpeciesTable& species = Resources::speciesTable;
+        shown.assign(threats.begin(), threats.begin() + min(threats.size(), kThreatsShown));
+        shownCount = threats.size();
+        shownThreshold = threshold;
+        shownCalculando = calculando;
+        built = true;
+
+        string heading = calculando ? "Calculando amenazas..."
+                                    : "Sin golpe de " + to_string(threshold) + "%: " + to_string(threats.size());
+        title = sf::Text(heading, font, 18);
+        title.setPosition(startX, startY - 28);
+        title.setFillColor(sf::Color::Black);
 
-                // 3. Buscar el índice del tipo de ataque en la cabecera
-                int attackTypeIndex = -1;
-                for (size_t i = 0; i < attackTypeHeaders.size(); ++i) {
-                    if (attackTypeHeaders[i] == attackType) {
-                        attackTypeIndex = i;
-                        break;
-                    }
-                }
+        texts.clear();
+        for (size_t i = 0; i < shown.size(); ++i) {
+            const DefenderThreat& threat = shown[i];
+            string line = species.names[threat.defender] + "  " + to_string((int)threat.bestPercent) + "%";
+            if (threat.bestPercent > 0) {
+                line += " (" + species.names[threat.attacker] + " - " + Resources::movesDatabase[threat.move].name + ")";
+            }
+            sf::Text text(line, font, 14);
+            text.setPosition(startX, startY + i * lineHeight);
+            text.setFillColor(sf::Color::Black);
+            texts.push_back(text);
+        }
+    }
 
-                // 4. Obtener el valor de efectividad de la fila encontrada
-                stringstream rowStream(defenseRow[0]);
-                string token;
-                vector<string> rowValues;
+    const float startX = 1200;
+    const float startY = 480;
+    const float lineHeight = 22;
 
-                // Saltar los primeros dos valores (tipos defensivos)
-                getline(rowStream, token, ',');
-                getline(rowStream, token, ',');
+    sf::Font& font;
+    bool built = false;
+    vector<DefenderThreat> shown;   // Solo las filas visibles
+    size_t shownCount = 0;
+    int shownThreshold = 0;
+    bool shownCalculando = false;
+    sf::Text title;
+    vector<sf::Text> texts;
+};
 
-                while (getline(rowStream, token, ',')) {
-                    rowValues.push_back(token);
-                }
+// Mejores atacantes de toda la pokedex contra el defensor, bajo su imagen
+class CountersPanel {
+public:
+    explicit CountersPanel(sf::Font& font) : font(font) {}
 
-                if (attackTypeIndex < rowValues.size()) {
-                    string effStr = rowValues[attackTypeIndex];
+    void draw(sf::RenderWindow& window, const vector<AttackResult>& counters) {
+        if (counters.empty()) return;
+        if (!built || !sameAttackResults(counters, shown)) rebuild(counters);
 
-                    if (effStr == "0.0") {
-                        E = 0.0f;
-                    } 
-                    else if (effStr == "0.5") {
-                        E = 0.5f;
-                    }
-                    else if (effStr == "2.0") {
-                        E = 2.0f;
-                    }
-                    else if (effStr == "1.0") {
-                        E = 1.0f;
-                    }
-                    else if (effStr == "0.25") {
-                        E = 0.25f;
-                    }
-                    else {
-                        E = 1.0f;
-                    }
-                } else {
-                    E = 1.0f;
-                }
+        window.draw(title);
+        for (const sf::Text& text : texts) window.draw(text);
+    }
 
-                float danioMin = 0.01f * B * E * 85 * ((((0.2f * N + 1) * A * P) / (25 * D)) + 2);
-                float danioMax = 0.01f * B * E * 100 * ((((0.2f * N + 1) * A * P) / (25 * D)) + 2);
+private:
+    void rebuild(const vector<AttackResult>& counters) {
+        shown = counters;
+        built = true;
 
-                results.push_back({
-                    name,
-                    moveIt->second.name,
-                    moveIt->second.type,
-                    floor(danioMin),
-                    floor(danioMax)
-                });
-            }
+        title = sf::Text("Mejores atacantes:", font, 18);
+        title.setPosition(startX, startY - 28);
+        title.setFillColor(sf::Color::Black);
+
+        texts.clear();
+        for (size_t i = 0; i < counters.size(); ++i) {
+            const auto& counter = counters[i];
+            string line = counter.pokemonName + " - " + counter.moveName + "  " +
+                          to_string((int)counter.minDamage) + "-" + to_string((int)counter.maxDamage);
+            sf::Text text(line, font, 14);
+            text.setPosition(startX, startY + i * lineHeight);
+            text.setFillColor(sf::Color::Black);
+            texts.push_back(text);
         }
     }
 
-    sort(results.begin(), results.end(), [](const AttackResult& a, const AttackResult& b) {
+    const float startX = 40;
+    const float startY = 620;
+    const float lineHeight = 22;
+
+    sf::Font& font;
+    bool built = false;
+    vector<AttackResult> shown;
+    sf::Text title;
+    vector<sf::Text> texts;
+};
+
+struct MoreDamage {
+    bool operator()(const AttackResult& a, const AttackResult& b) const {
         return a.maxDamage > b.maxDamage;
-    });
+    }
+};
+
+// Atacante, nivel, ataques y defensor con los que se calcula un slot de la derecha
+struct SlotKey {
+    int attacker = -1;
+    int level = 0;
+    vector<int> moves;
+    int defender = -1;
+    int defenderLevel = 0;
+
+    bool operator==(const SlotKey& o) const {
+        return attacker == o.attacker && level == o.level && moves == o.moves &&
+               defender == o.defender && defenderLevel == o.defenderLevel;
+    }
+};
+
+// Resultados de un dropdown de la derecha, con la clave con la que se calcularon
+struct SlotResults {
+    SlotKey key;
+    vector<AttackResult> results;
+};
+
+SlotKey claveSlot(const Dropdown& mainDropdown, const Dropdown& dd) {
+    const DamageEngine& engine = Resources::damageEngine;
+    SlotKey key;
+    key.attacker = engine.findSpecies(dd.getSelectedItem());        // Atacante (derecha)
+    key.level = dd.getLevel();
+    key.moves = dd.getMoves();
+    key.defender = engine.findSpecies(mainDropdown.getSelectedItem());  // Defensor (izquierda)
+    key.defenderLevel = mainDropdown.getLevel();
+    return key;
+}
+
+// Se ejecuta en segundo plano; deja de calcular si el slot volvió a cambiar
+vector<AttackResult> calcularSlot(const SlotKey& key, const string& name, const BackgroundJobs::Token& token) {
+    const DamageEngine& engine = Resources::damageEngine;
+    vector<AttackResult> results;
 
+    Combatant attackerStats = Resources::statCalc.combatant(key.attacker, key.level);
+    Combatant defenderStats = Resources::statCalc.combatant(key.defender, key.defenderLevel);
+    for (int moveId : key.moves) {
+        if (token.stale()) return {};
+        const MoveData& move = engine.move(moveId);
+        if (move.category == MoveCategory::Status) continue;
+
+        DamageRange range = engine.compute(attackerStats, moveId, defenderStats);
+        results.push_back({
+            name,
+            move.name,
+            typeName(move.type),
+            range.minDamage,
+            range.maxDamage,
+            engine.koChances(attackerStats, moveId, defenderStats)
+        });
+    }
     return results;
 }
+
+// Los mejores ataques de todos los slots, en el mismo orden que una pasada completa
+vector<AttackResult> combinarSlots(const vector<SlotResults>& slots, size_t topK = kResultsShown) {
+    TopK<AttackResult, MoreDamage> best(topK);
+    for (const SlotResults& slot : slots) {
+        for (const AttackResult& result : slot.results) best.push(result);
+    }
+    return best.sorted();
+}
+
+// Se ejecuta en segundo plano; la búsqueda se abandona si cambió el defensor o algún nivel
+vector<AttackResult> buscarCounters(int defender, int defenderLevel, int attackerLevel,
+                                    const TeamOptimizer& optimizer, const BackgroundJobs::Token& token,
+                                    size_t n = kCountersShown) {
+    vector<AttackResult> counters;
+    const DamageEngine& engine = Resources::damageEngine;
+
+    auto cancelled = [&token]() { return token.stale(); };
+    for (const TeamMember& member : optimizer.counters(defender, defenderLevel, attackerLevel, n, cancelled)) {
+        if (member.moveCount == 0) continue;
+        const MoveData& best = engine.move(member.moves[0]);
+        counters.push_back({engine.speciesTable().names[member.species], best.name, typeName(best.type),
+                            member.damage.minDamage, member.damage.maxDamage, {}});
+    }
+    return counters;
+}
+
+// Los atacantes de la derecha con sus ataques, para el barrido contra todos los defensores
+vector<TeamSlot> equipoSeleccionado(const vector<Dropdown>& rightDropdowns) {
+    vector<TeamSlot> team;
+    for (const Dropdown& dd : rightDropdowns) {
+        int attacker = Resources::damageEngine.findSpecies(dd.getSelectedItem());
+        if (attacker < 0 || dd.getMoves().empty()) continue;
+
+        TeamSlot slot{static_cast<SpeciesId>(attacker), dd.getLevel(), {}};
+        for (int moveId : dd.getMoves()) slot.moves.push_back(static_cast<MoveId>(moveId));
+        team.push_back(slot);
+    }
+    return team;
+}
+
+// Coloca el equipo del optimizador, al nivel con el que se buscó, en los
+// dropdowns de la derecha; los slots que cambian se recalculan solos
+void colocarEquipo(const vector<TeamMember>& team, int level, vector<Dropdown>& rightDropdowns) {
+    const DamageEngine& engine = Resources::damageEngine;
+    size_t slot = 0;
+    for (const TeamMember& member : team) {
+        if (member.moveCount == 0) continue;
+        const string& name = engine.speciesTable().names[member.species];
+        vector<int> moves(member.moves, member.moves + member.moveCount);
+        if (slot < rightDropdowns.size() && rightDropdowns[slot].select(name, level, moves)) ++slot;
+    }
+}
+
+// Canales de las búsquedas en toda la pokedex. Van en otro BackgroundJobs que
+// el de los slots (un canal por slot de la derecha), con un hilo por canal, para
+// que una búsqueda larga nunca deje a los slots sin hilo libre
+const size_t kCountersChannel = 0;
+const size_t kThreatsChannel = 1;
+const size_t kTeamChannel = 2;
+const size_t kSearchChannelCount = 3;
+
 // Main Function
 int main() {
-    Resources::loadTypeChart("type-chart.csv");
-    auto pokemonStats = Resources::loadPokemonStats("pokemon.csv");
-    Resources::loadMovesData("moves.csv");
-
     vector<string> pokemonNames;
     vector<AttackResult> currentResults;
-    auto pokedex = Resources::loadPokemonData("pokemon_data.csv", pokemonNames);
-
-    if (pokemonNames.empty()) {
-        cerr << "No se cargaron nombres del CSV. Verifica el archivo." << endl;
-        return 1;
+    unordered_map<string, Pokemon> pokedex;
+    sf::Image fondoImage;
+
+    // Las cargas son independientes entre sí: datos, fuente e imágenes van en paralelo
+    ThreadPool loaderPool(4);
+    StartupLoader loader(loaderPool);
+
+    if (Resources::dataset.open("pokemon.dat")) {
+        loader.add("pokemon.dat", []() { return Resources::loadDataset(); });
+        loader.add("pokedex", [&]() {
+            pokedex = Resources::loadPokemonData(Resources::dataset, pokemonNames);
+            return true;
+        });
+    } else {
+        loader.add("type-chart.csv", []() { Resources::loadTypeChart("type-chart.csv"); return true; });
+        loader.add("pokemon.csv", []() { Resources::loadPokemonStats("pokemon.csv"); return true; });
+        loader.add("moves.csv", []() { Resources::loadMovesData("moves.csv"); return true; });
+        loader.add("pokemon_data.csv", [&]() {
+            pokedex = Resources::loadPokemonData("pokemon_data.csv", pokemonNames);
+            return true;
+        });
     }
 
+    loader.add("arial.ttf", []() {
+        if (!Resources::globalFont.loadFromFile("arial.ttf")) {
+            cerr << "Error: No se pudo cargar la fuente arial.ttf" << endl;
+            return false;
+        }
+        return true;
+    });
+    loader.add("tipos.png", []() { Resources::loadTypesImage("tipos.png"); return true; });
+    loader.add("fondo.jpg", [&]() {
+        if (!fondoImage.loadFromFile("fondo.jpg")) {
+            cerr << "Error: No se pudo cargar fondo.jpg" << endl;
+            return false;
+        }
+        return true;
+    });
+
+    // La ventana se crea mientras tanto en el hilo principal
     int screenWidth = 1600;
     int screenHeight = 900;
     sf::RenderWindow window(sf::VideoMode(screenWidth, screenHeight), "Sistema Experto - Pokémon");
 
-    if (!Resources::globalFont.loadFromFile("arial.ttf")) {
-        cerr << "Error: No se pudo cargar la fuente arial.ttf" << endl;
+    if (!loader.wait()) {
         return 1;
     }
 
-    Resources::initTypeSprites();
+    // Sin pokemon.dat los learnsets dependen de las tablas ya cargadas
+    if (!Resources::dataset.isOpen()) {
+        Resources::loadLearnsets("movesets.csv");
+    }
 
-    sf::Texture fondoTexture;
-    if (!fondoTexture.loadFromFile("fondo.jpg")) {
-        cerr << "Error: No se pudo cargar fondo.png" << endl;
+    if (pokemonNames.empty()) {
+        cerr << "No se cargaron nombres del CSV. Verifica el archivo." << endl;
         return 1;
     }
+
+    // Las subidas a la GPU se hacen en el hilo de la ventana
+    Resources::initTypeSprites();
+    if (!Resources::speciesTextures.openPack("sprites/sprites.pak")) {
+        cout << "Sin sprites.pak (make sprites); se usan las imágenes sueltas" << endl;
+    }
+    if (!Resources::spriteAtlas.load("sprites")) {
+        cout << "Sin atlas de miniaturas (make sprites); se usan las imágenes sueltas" << endl;
+    }
+
+    // Los cálculos pesados usan todos los núcleos
+    ThreadPool computePool;
+    TeamOptimizer teamOptimizer(Resources::damageEngine, Resources::learnsets, Resources::statCalc, computePool);
+
+    // Solo se proponen especies que se pueden elegir en los dropdowns
+    vector<bool> seleccionables(Resources::speciesTable.size(), false);
+    for (const string& name : pokemonNames) {
+        int id = Resources::speciesTable.find(name);
+        if (id >= 0) seleccionables[id] = true;
+    }
+    TeamSweep teamSweep(Resources::damageEngine, Resources::statCalc, computePool);
+    teamSweep.setCandidates(seleccionables);
+    teamOptimizer.setCandidates(move(seleccionables));
+
+    // Resultados por dropdown de la derecha, para recalcular solo los que cambian
+    vector<SlotResults> slots(kTeamSize);
+
+    vector<DefenderThreat> threats;
+    int threatsThreshold = 0;   // Umbral con el que se calculó threats; 0 = sin calcular
+
+    // Se recalculan en cuanto cambia el defensor, su nivel o el de los atacantes
+    vector<AttackResult> counters;
+    string countersDefender;
+    int countersLevel = 0;
+    int countersAttackerLevel = 0;
+
+    sf::Texture fondoTexture;
+    fondoTexture.loadFromImage(fondoImage);
     sf::Sprite fondoSprite(fondoTexture);
 
     sf::Vector2u textureSize = fondoTexture.getSize();
@@ -1018,7 +1519,7 @@ int main() {
     float rightStartX = screenWidth * 1.0f / 2.0f - 160;
     float spacingX = 160;
     float spacingY = 320;
-    for (int i = 0; i < 6; ++i) {
+    for (size_t i = 0; i < kTeamSize; ++i) {
         float x = rightStartX + (i % 3) * spacingX;
         float y = 100 + (i / 3) * spacingY;
         rightDropdowns.emplace_back(x, y, 140, 30.0f, pokemonNames, Resources::globalFont);
@@ -1032,6 +1533,47 @@ int main() {
     textoProcesar.setPosition(botonProcesar.getPosition().x + 40, botonProcesar.getPosition().y + 5);
     textoProcesar.setFillColor(sf::Color::Black);
 
+    // Optimizador de equipo: por daño máximo o por probabilidad de KO
+    sf::RectangleShape botonEquipoDanio(sf::Vector2f(200, 40));
+    botonEquipoDanio.setPosition(screenWidth - 680, screenHeight - 80);
+    botonEquipoDanio.setFillColor(sf::Color(200, 200, 150));
+
+    string etiquetaDanio = "Equipo: daño";
+    sf::Text textoEquipoDanio(sf::String::fromUtf8(etiquetaDanio.begin(), etiquetaDanio.end()), Resources::globalFont, 20);
+    textoEquipoDanio.setPosition(botonEquipoDanio.getPosition().x + 40, botonEquipoDanio.getPosition().y + 5);
+    textoEquipoDanio.setFillColor(sf::Color::Black);
+
+    sf::RectangleShape botonEquipoKo(sf::Vector2f(200, 40));
+    botonEquipoKo.setPosition(screenWidth - 460, screenHeight - 80);
+    botonEquipoKo.setFillColor(sf::Color(200, 200, 150));
+
+    sf::Text textoEquipoKo("Equipo: KO", Resources::globalFont, 20);
+    textoEquipoKo.setPosition(botonEquipoKo.getPosition().x + 40, botonEquipoKo.getPosition().y + 5);
+    textoEquipoKo.setFillColor(sf::Color::Black);
+
+    // Barrido del equipo contra toda la pokedex
+    sf::RectangleShape botonAmenazas(sf::Vector2f(200, 40));
+    botonAmenazas.setPosition(screenWidth - 900, screenHeight - 80);
+    botonAmenazas.setFillColor(sf::Color(200, 150, 150));
+
+    sf::Text textoAmenazas("Amenazas", Resources::globalFont, 20);
+    textoAmenazas.setPosition(botonAmenazas.getPosition().x + 40, botonAmenazas.getPosition().y + 5);
+    textoAmenazas.setFillColor(sf::Color::Black);
+
+    ResultsPanel resultsPanel(Resources::globalFont);
+    CountersPanel countersPanel(Resources::globalFont);
+    ThreatsPanel threatsPanel(Resources::globalFont);
+
+    LevelInput umbralInput(screenWidth - 820, screenHeight - 120, 50, 25, Resources::globalFont, "Umbral %: ", 50);
+    // Nivel de los atacantes que proponen el optimizador y los mejores atacantes;
+    // el defensor usa el suyo
+    LevelInput nivelEquipoInput(screenWidth - 560, screenHeight - 120, 50, 25, Resources::globalFont, "Nivel: ", 50);
+
+    // Los cálculos corren fuera del hilo de la ventana; se declaran después de todo
+    // lo que usan los trabajos para que se destruyan antes
+    BackgroundJobs jobs(kTeamSize, 2);
+    BackgroundJobs searches(kSearchChannelCount, kSearchChannelCount);
+
     while (window.isOpen()) {
         sf::Event event;
         while (window.pollEvent(event)) {
@@ -1042,14 +1584,98 @@ int main() {
             mainDropdown.handleEvent(event, mousePos, currentlyExpanded);
             for (auto& dd : rightDropdowns)
                 dd.handleEvent(event, mousePos, currentlyExpanded);
+            umbralInput.handleEvent(event, mousePos);
+            nivelEquipoInput.handleEvent(event, mousePos);
 
             if (event.type == sf::Event::MouseButtonPressed) {
+                bool equipoDanio = botonEquipoDanio.getGlobalBounds().contains(mousePos);
+                bool equipoKo = botonEquipoKo.getGlobalBounds().contains(mousePos);
+                int defender = Resources::damageEngine.findSpecies(mainDropdown.getSelectedItem());
+
                 if (botonProcesar.getGlobalBounds().contains(mousePos)) {
-                    currentResults = procesar(mainDropdown, rightDropdowns, pokedex, pokemonStats);
+                    // Fuerza un recálculo completo
+                    for (SlotResults& slot : slots) slot.key = SlotKey();
+                } else if ((equipoDanio || equipoKo) && defender >= 0) {
+                    TeamObjective objective = equipoDanio ? TeamObjective::Damage : TeamObjective::KoChance;
+                    int defenderLevel = mainDropdown.getLevel();
+                    int attackerLevel = nivelEquipoInput.getLevel();
+                    searches.launch(kTeamChannel, [&, defender, defenderLevel, attackerLevel, objective](const BackgroundJobs::Token& token) {
+                        vector<TeamMember> team = teamOptimizer.optimize(defender, defenderLevel, attackerLevel, objective,
+                                                                         kTeamSize, [&token]() { return token.stale(); });
+                        return function<void()>([&, team, attackerLevel]() {
+                            colocarEquipo(team, attackerLevel, rightDropdowns);
+                        });
+                    });
+                } else if (botonAmenazas.getGlobalBounds().contains(mousePos)) {
+                    int threshold = umbralInput.getLevel();
+                    int defenderLevel = mainDropdown.getLevel();   // Todos los defensores al nivel del de la izquierda
+                    vector<TeamSlot> team = equipoSeleccionado(rightDropdowns);
+                    threatsThreshold = threshold;
+                    threats.clear();
+                    searches.launch(kThreatsChannel, [&, threshold, defenderLevel, team](const BackgroundJobs::Token& token) {
+                        vector<DefenderThreat> found;
+                        if (!team.empty()) {
+                            found = teamSweep.threats(team, defenderLevel, static_cast<float>(threshold),
+                                                      [&token]() { return token.stale(); });
+                        }
+                        return function<void()>([&, found]() { threats = found; });
+                    });
+                }
+            }
+        }
+
+        // Resultados de los trabajos que terminaron desde el último frame
+        jobs.drain();
+        searches.drain();
+
+        // Solo se recalculan los slots que cambiaron; cada uno llega por su cuenta
+        bool calculando = false;
+        for (size_t i = 0; i < rightDropdowns.size(); ++i) {
+            SlotKey key = claveSlot(mainDropdown, rightDropdowns[i]);
+            if (!(key == slots[i].key)) {
+                slots[i].key = key;
+                slots[i].results.clear();
+                currentResults = combinarSlots(slots);
+
+                if (key.attacker < 0 || key.defender < 0) {
+                    jobs.cancel(i);
+                } else {
+                    string name = rightDropdowns[i].getSelectedItem();
+                    jobs.launch(i, [&, i, key, name](const BackgroundJobs::Token& token) {
+                        vector<AttackResult> results = calcularSlot(key, name, token);
+                        return function<void()>([&, i, results]() {
+                            slots[i].results = results;
+                            currentResults = combinarSlots(slots);
+                        });
+                    });
                 }
             }
+            calculando = calculando || jobs.busy(i);
         }
 
+        if (mainDropdown.getSelectedItem() != countersDefender || mainDropdown.getLevel() != countersLevel ||
+            nivelEquipoInput.getLevel() != countersAttackerLevel) {
+            countersDefender = mainDropdown.getSelectedItem();
+            countersLevel = mainDropdown.getLevel();
+            countersAttackerLevel = nivelEquipoInput.getLevel();
+            counters.clear();
+
+            int defender = Resources::damageEngine.findSpecies(countersDefender);
+            if (defender < 0) {
+                searches.cancel(kCountersChannel);
+            } else {
+                int defenderLevel = countersLevel;
+                int attackerLevel = countersAttackerLevel;
+                searches.launch(kCountersChannel, [&, defender, defenderLevel, attackerLevel](const BackgroundJobs::Token& token) {
+                    vector<AttackResult> found = buscarCounters(defender, defenderLevel, attackerLevel, teamOptimizer, token);
+                    return function<void()>([&, found]() { counters = found; });
+                });
+            }
+        }
+
+        // Imágenes decodificadas en segundo plano; pocas por frame para no trabarlo
+        Resources::speciesTextures.upload(4);
+
         window.clear(sf::Color::White);
         window.draw(fondoSprite);
         mainDropdown.draw(window);
@@ -1057,7 +1683,19 @@ int main() {
             dd.draw(window);
         window.draw(botonProcesar);
         window.draw(textoProcesar);
-        drawResults(window, currentResults, Resources::globalFont);
+        window.draw(botonEquipoDanio);
+        window.draw(textoEquipoDanio);
+        window.draw(botonEquipoKo);
+        window.draw(textoEquipoKo);
+        resultsPanel.draw(window, currentResults, calculando);
+        countersPanel.draw(window, counters);
+        window.draw(botonAmenazas);
+        window.draw(textoAmenazas);
+        umbralInput.draw(window);
+        nivelEquipoInput.draw(window);
+        if (threatsThreshold > 0) {
+            threatsPanel.draw(window, threats, threatsThreshold, searches.busy(kThreatsChannel));
+        }
         window.display();
     }
 
@@ -0,0 +1,94 @@
+// Simulador Monte Carlo de combates 1 contra 1 desde la línea de comandos,
+// seguido de la búsqueda expectimax del mismo combate.
+//
+// Uso: simulate <pokemon A> <movimientos A> <pokemon B> <movimientos B> [nivel] [partidas] [semilla]
+// Los movimientos van separados por comas: simulate Garchomp "Earthquake,Dragon Claw" Blissey "Seismic Toss"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BattleSim.hpp"
+#include "Dataset.hpp"
+#include "Expectimax.hpp"
+
+using namespace std;
+
+static bool parseSide(const DamageEngine& engine, const StatCalc& stats, const string& name,
+                      const string& moveList, int level, BattleSide& side) {
+    int species = engine.findSpecies(name);
+    if (species < 0) {
+        cerr << "Especie desconocida: " << name << endl;
+        return false;
+    }
+    side.mon = stats.combatant(static_cast<SpeciesId>(species), level);
+
+    stringstream list(moveList);
+    string moveName;
+    while (getline(list, moveName, ',')) {
+        int move = engine.findMove(moveName);
+        if (move < 0) {
+            cerr << "Movimiento desconocido: " << moveName << endl;
+            return false;
+        }
+        side.moves.push_back(static_cast<MoveId>(move));
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 5) {
+        cerr << "Uso: simulate <pokemon A> <movimientos A> <pokemon B> <movimientos B> [nivel] [partidas] [semilla]" << endl;
+        return 1;
+    }
+    int level = argc > 5 ? stoi(argv[5]) : 50;
+    uint64_t games = argc > 6 ? stoull(argv[6]) : 1000000;
+    uint64_t seed = argc > 7 ? stoull(argv[7]) : 1;
+
+    TypeChart typeChart;
+    SpeciesTable species;
+    MoveTable moves;
+    Dataset dataset;
+    if (dataset.open("pokemon.dat")) {
+        typeChart.loadFromDataset(dataset);
+        species.loadFromDataset(dataset);
+        moves.loadFromDataset(dataset);
+    } else if (!typeChart.loadFromCsv("type-chart.csv") ||
+               !species.loadFromCsv("pokemon.csv") ||
+               !moves.loadFromCsv("moves.csv")) {
+        return 1;
+    }
+
+    DamageEngine engine(typeChart, species, moves);
+    StatCalc stats(species);
+    BattleSide a, b;
+    if (!parseSide(engine, stats, argv[1], argv[2], level, a) ||
+        !parseSide(engine, stats, argv[3], argv[4], level, b)) {
+        return 1;
+    }
+
+    ThreadPool pool;
+    BattleSimulator simulator(engine, pool);
+    auto start = chrono::steady_clock::now();
+    SimResult r = simulator.run(a, b, games, seed);
+    auto ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+
+    cout << argv[1] << " gana " << r.winRate * 100 << "% [" << r.ciLow * 100 << ", " << r.ciHigh * 100
+         << "] (IC 95%) en " << r.games << " partidas" << endl;
+    cout << "Victorias " << r.winsA << " / " << r.winsB << ", empates " << r.draws
+         << ", " << r.averageTurns << " turnos de media, " << ms << " ms con " << pool.size() << " hilos" << endl;
+
+    ExpectimaxSolver solver(engine);
+    start = chrono::steady_clock::now();
+    SolverResult e = solver.solve(a, b);
+    ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+
+    cout << "Expectimax: " << argv[1] << " gana " << e.winProbability * 100 << "%"
+         << (e.exact ? " (exacto)" : " (estimado)") << " a " << e.depth << " turnos, " << e.nodes
+         << " nodos, " << ms << " ms";
+    if (e.bestMove >= 0) cout << "; mejor ataque: " << engine.move(a.moves[e.bestMove]).name;
+    cout << endl;
+    return 0;
+}